@@ -42,6 +42,10 @@ android {
         prefab = true
         compose = true
     }
+    androidResources {
+        // the audio bank is memory mapped by the native code, so it has to stay uncompressed in the apk
+        noCompress += "bank"
+    }
     externalNativeBuild {
         cmake {
             path = file("src/main/cpp/CMakeLists.txt")
@@ -0,0 +1,12 @@
+#version 300 es
+precision mediump float;
+
+in vec2 textureCoords;
+in vec4 color;
+uniform sampler2D uTexture;
+
+out vec4 outColor;
+
+void main() {
+    outColor = texture(uTexture, textureCoords) * color;
+}
@@ -0,0 +1,36 @@
+#version 300 es
+precision mediump float;
+
+// Instanced, VBO-less squares like main.vert: the corner comes from gl_VertexID, the rest from
+// the particle.
+const vec2 vertexPos[4] = vec2[4](
+    vec2(-0.5, -0.5),	// bottom left
+    vec2( 0.5, -0.5),	// bottom right
+    vec2( 0.5,  0.5),	// top right
+    vec2(-0.5,  0.5) 	// top left
+);
+
+// flipped, like main.vert.
+const vec2 textureCoordinates[4] = vec2[4](
+    vec2(0, 1),
+    vec2(1, 1),
+    vec2(1, 0),
+    vec2(0, 0)
+);
+
+const int indices[6] = int[6](0, 2, 1, 2, 0, 3);
+
+layout(location = 0) in vec4 particle;   // x, y, size, fade
+layout(location = 1) in vec4 particleColor;
+
+uniform mat4 viewProjection;
+out vec2 textureCoords;
+out vec4 color;
+
+void main() {
+    int index = indices[gl_VertexID];
+
+    gl_Position = viewProjection * vec4(particle.xy + vertexPos[index] * particle.z, 0, 1);
+    textureCoords = textureCoordinates[index];
+    color = vec4(particleColor.rgb, particleColor.a * particle.w);
+}
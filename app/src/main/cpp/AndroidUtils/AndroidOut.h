@@ -1,11 +1,14 @@
 #ifndef ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
 #define ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
 
-#include <android/log.h>
 #include <sstream>
 
+#include "../Core/Log.h"
+
 /*!
- * Use this to log strings out to logcat. Note that you should use std::endl to commit the line
+ * Use this to log strings out to logcat. Note that you should use std::endl to commit the line.
+ * The line is still formatted on the calling thread, so prefer the LOG macros (Core/Log.h) on
+ * anything that runs per frame.
  *
  * ex:
  *  aout << "Hello World" << std::endl;
@@ -26,7 +29,9 @@ public:
 
 protected:
     virtual int sync() override {
-        __android_log_print(ANDROID_LOG_DEBUG, logTag_, "%s", str().c_str());
+        // handed to the log thread, writing to logcat happens there.
+        std::string const line = str();
+        Log::writeText(Log::Level::Debug, logTag_, line.data(), line.size());
         str("");
         return 0;
     }
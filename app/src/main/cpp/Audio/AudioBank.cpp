@@ -0,0 +1,71 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AudioBank.h"
+
+#include <cstring>
+
+#include "ImaAdpcm.h"
+
+bool AudioBank::open(const uint8_t* data, size_t size) {
+    data_ = nullptr;
+    tracks_ = nullptr;
+    trackCount_ = 0;
+
+    if (data == nullptr || size < sizeof(AudioBankHeader))
+        return false;
+
+    AudioBankHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, audioBankMagic, sizeof(audioBankMagic)) != 0 || header.version != audioBankVersion)
+        return false;
+    // the index is used in place, so it has to be aligned and inside the buffer.
+    if (header.indexOffset % alignof(AudioBankTrack) != 0
+        || header.indexOffset > size
+        || header.trackCount > (size - header.indexOffset) / sizeof(AudioBankTrack))
+        return false;
+
+    const auto* tracks = reinterpret_cast<const AudioBankTrack*>(data + header.indexOffset);
+    for (uint32_t i = 0; i < header.trackCount; ++i) {
+        AudioBankTrack const& track = tracks[i];
+        if (track.dataOffset > size || track.dataSize > size - track.dataOffset)
+            return false;
+        if (track.channels < 1 || track.channels > 2 || track.sampleRate == 0)
+            return false;
+        if (std::memchr(track.name, '\0', sizeof(track.name)) == nullptr)
+            return false;
+
+        switch (track.codec) {
+            case AudioCodec::Pcm16:
+                if (track.dataSize < static_cast<uint64_t>(track.frameCount) * track.channels * sizeof(int16_t))
+                    return false;
+                break;
+            case AudioCodec::ImaAdpcm: {
+                if (track.blockBytes <= ImaAdpcm::headerBytesPerChannel * track.channels
+                    || track.framesPerBlock != ImaAdpcm::framesPerBlock(track.blockBytes, track.channels))
+                    return false;
+                uint64_t const blocks = (static_cast<uint64_t>(track.frameCount) + track.framesPerBlock - 1) / track.framesPerBlock;
+                if (track.dataSize < blocks * track.blockBytes)
+                    return false;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    data_ = data;
+    size_ = size;
+    tracks_ = tracks;
+    trackCount_ = header.trackCount;
+    return true;
+}
+
+AudioBankTrack const* AudioBank::find(const char* name) const {
+    for (uint32_t i = 0; i < trackCount_; ++i) {
+        if (std::strncmp(tracks_[i].name, name, audioBankNameLength) == 0)
+            return &tracks_[i];
+    }
+    return nullptr;
+}
@@ -0,0 +1,76 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AUDIOBANK_H
+#define DOODLE_AUDIOBANK_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * On-disk layout of an audio bank (.bank), little endian. Everything is fixed size and naturally
+ * aligned so the file can be used straight out of a memory mapping:
+ *
+ *     AudioBankHeader
+ *     AudioBankTrack[trackCount]                  (at header.indexOffset)
+ *     track data, each aligned to dataAlignment   (at track.dataOffset)
+ *
+ * Tracks are written by tools/audiobank.
+ */
+constexpr char     audioBankMagic[4]     = {'D', 'B', 'N', 'K'};
+constexpr uint32_t audioBankVersion      = 1;
+constexpr uint32_t audioBankNameLength   = 32;
+constexpr uint32_t audioBankDataAlignment = 64;
+
+enum class AudioCodec : uint32_t {
+    Pcm16    = 0,
+    ImaAdpcm = 1
+};
+
+struct AudioBankHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t trackCount;
+    uint32_t indexOffset;
+};
+
+struct AudioBankTrack {
+    char       name[audioBankNameLength];   // nul terminated
+    AudioCodec codec;
+    uint32_t   sampleRate;
+    uint32_t   channels;
+    uint32_t   frameCount;
+    uint32_t   blockBytes;                  // adpcm only, size of one block
+    uint32_t   framesPerBlock;              // adpcm only
+    uint64_t   dataOffset;                  // from the start of the file
+    uint64_t   dataSize;
+};
+
+static_assert(sizeof(AudioBankHeader) == 16, "bank header layout changed");
+static_assert(sizeof(AudioBankTrack) == 72, "bank track layout changed");
+
+/*!
+ * Read-only view of a bank held in memory (usually an mmap'd asset). Nothing is copied, the
+ * returned tracks and data point into the caller's buffer, which must outlive the view.
+ */
+class AudioBank {
+public:
+    // validates the header and the index, returns false if the buffer is not a usable bank.
+    bool open(const uint8_t* data, size_t size);
+
+    uint32_t trackCount() const { return trackCount_; }
+    AudioBankTrack const& track(uint32_t index) const { return tracks_[index]; }
+    const uint8_t* trackData(AudioBankTrack const& track) const { return data_ + track.dataOffset; }
+
+    // returns nullptr if there is no track with that name.
+    AudioBankTrack const* find(const char* name) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    const AudioBankTrack* tracks_ = nullptr;
+    uint32_t trackCount_ = 0;
+};
+
+#endif //DOODLE_AUDIOBANK_H
@@ -0,0 +1,28 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AUDIOHANDLES_H
+#define DOODLE_AUDIOHANDLES_H
+
+#include <cstdint>
+
+// identifies a preloaded sound, cheap to copy and store in gameplay code.
+struct SoundId{
+    static constexpr uint16_t invalidIndex = 0xFFFF;
+    uint16_t index = invalidIndex;
+
+    bool isValid() const { return index != invalidIndex; }
+};
+
+// identifies one playback of a sound. the generation goes stale once the voice is stopped or reused,
+// after which every operation on the handle is a no-op.
+struct VoiceHandle{
+    static constexpr uint16_t invalidSlot = 0xFFFF;
+    uint16_t slot = invalidSlot;
+    uint16_t generation = 0;
+
+    bool isValid() const { return slot != invalidSlot; }
+};
+
+#endif //DOODLE_AUDIOHANDLES_H
@@ -0,0 +1,249 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AudioMixer.h"
+
+#include <algorithm>
+
+#include "ImaAdpcm.h"
+
+namespace {
+    constexpr uint32_t unitStep = 1u << 16;
+}
+
+AudioSource AudioSource::pcm16(const int16_t* samples, uint32_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    return AudioSource{AudioCodec::Pcm16, reinterpret_cast<const uint8_t*>(samples), frameCount, channels, sampleRate, 0, 0};
+}
+
+AudioSource AudioSource::bankTrack(AudioBank const& bank, AudioBankTrack const& track) {
+    return AudioSource{track.codec, bank.trackData(track), track.frameCount, track.channels, track.sampleRate,
+                       track.blockBytes, track.framesPerBlock};
+}
+
+AudioMixer::AudioMixer(AudioStatsCollector& stats) :
+        stats { stats }
+{}
+
+int AudioMixer::play(AudioSource const& source, float gain, bool loop, int64_t requestNs) {
+    if (!isPlayable(source))
+        return -1;
+
+    for (int i = 0; i < maxVoices; ++i) {
+        // only the game thread ever sets a voice busy, so a free voice stays free until we claim it.
+        if (busy[i].load(std::memory_order_acquire))
+            continue;
+        busy[i].store(true, std::memory_order_relaxed);
+
+        Command command{CommandType::Play, static_cast<uint8_t>(i), loop, gain, source, requestNs};
+        if (!commands.push(command)) {
+            busy[i].store(false, std::memory_order_relaxed);
+            stats.recordOverrun();
+            return -1;
+        }
+        return i;
+    }
+    // every voice is taken, the request is dropped.
+    stats.recordOverrun();
+    return -1;
+}
+
+void AudioMixer::stop(int voice) {
+    if (voice < 0 || voice >= maxVoices)
+        return;
+    if (!commands.push(Command{CommandType::Stop, static_cast<uint8_t>(voice), false, 0.f, {}, 0}))
+        stats.recordOverrun();
+}
+
+void AudioMixer::setGain(int voice, float gain) {
+    if (voice < 0 || voice >= maxVoices)
+        return;
+    if (!commands.push(Command{CommandType::SetGain, static_cast<uint8_t>(voice), false, gain, {}, 0}))
+        stats.recordOverrun();
+}
+
+bool AudioMixer::isPlaying(int voice) const {
+    return voice >= 0 && voice < maxVoices && busy[voice].load(std::memory_order_acquire);
+}
+
+void AudioMixer::render(int16_t* output, uint32_t frameCount, int64_t nowNs) {
+    applyCommands();
+
+    while (frameCount > 0) {
+        uint32_t const frames = std::min(frameCount, maxFramesPerCall);
+        std::fill_n(accumulator.begin(), frames * outputChannels, 0);
+
+        for (int i = 0; i < maxVoices; ++i) {
+            Voice& voice = voices[i];
+            if (!voice.active)
+                continue;
+            if (!voice.started) {
+                voice.started = true;
+                stats.recordPlayLatency(voice.requestNs, nowNs);
+            }
+            mixVoice(voice, accumulator.data(), frames);
+            if (!voice.active)
+                busy[i].store(false, std::memory_order_release);
+        }
+
+        for (uint32_t s = 0; s < frames * outputChannels; ++s)
+            output[s] = static_cast<int16_t>(std::clamp(accumulator[s], -32768, 32767));
+
+        output += frames * outputChannels;
+        frameCount -= frames;
+    }
+}
+
+void AudioMixer::applyCommands() {
+    Command command;
+    while (commands.pop(command)) {
+        Voice& voice = voices[command.voice];
+        switch (command.type) {
+            case CommandType::Play:
+                startVoice(voice, command);
+                break;
+            case CommandType::Stop:
+                if (voice.active) {
+                    voice.active = false;
+                    busy[command.voice].store(false, std::memory_order_release);
+                }
+                break;
+            case CommandType::SetGain:
+                voice.gainQ15 = toQ15(command.gain);
+                break;
+        }
+    }
+}
+
+void AudioMixer::startVoice(Voice& voice, Command const& command) {
+    voice.source       = command.source;
+    voice.cursor       = 0;
+    voice.gainQ15      = toQ15(command.gain);
+    voice.loop         = command.loop;
+    voice.active       = true;
+    voice.started      = false;
+    voice.exhausted    = false;
+    voice.requestNs    = command.requestNs;
+    voice.decodedBlock = -1;
+    voice.step = static_cast<uint32_t>((static_cast<uint64_t>(voice.source.sampleRate) << 16) / sampleRate);
+    voice.frac = 0;
+    if (voice.source.codec == AudioCodec::Pcm16 && voice.step == unitStep)
+        return;
+
+    // prime the interpolator with the first two frames.
+    if (!readFrame(voice, voice.current))
+        voice.active = false;
+    if (!readFrame(voice, voice.next)) {
+        std::copy_n(voice.current, 2, voice.next);
+        voice.exhausted = true;
+    }
+}
+
+void AudioMixer::mixVoice(Voice& voice, int32_t* out, uint32_t frameCount) {
+    // plain pcm at the output rate can be mixed straight out of the source, without the interpolator.
+    if (voice.source.codec == AudioCodec::Pcm16 && voice.step == unitStep)
+        mixDirect(voice, out, frameCount);
+    else
+        mixResampled(voice, out, frameCount);
+}
+
+void AudioMixer::mixDirect(Voice& voice, int32_t* out, uint32_t frameCount) {
+    AudioSource const& source = voice.source;
+    const auto* samples = reinterpret_cast<const int16_t*>(source.data);
+    uint32_t cursor = voice.cursor;
+    uint32_t written = 0;
+
+    while (written < frameCount && voice.active) {
+        uint32_t const frames = std::min(source.frameCount - cursor, frameCount - written);
+        const int16_t* in = samples + static_cast<size_t>(cursor) * source.channels;
+        int32_t* dst = out + written * outputChannels;
+
+        if (source.channels == 1) {
+            for (uint32_t f = 0; f < frames; ++f) {
+                int32_t const sample = (in[f] * voice.gainQ15) >> 15;
+                dst[f * 2]     += sample;
+                dst[f * 2 + 1] += sample;
+            }
+        } else {
+            for (uint32_t f = 0; f < frames; ++f) {
+                dst[f * 2]     += (in[f * 2]     * voice.gainQ15) >> 15;
+                dst[f * 2 + 1] += (in[f * 2 + 1] * voice.gainQ15) >> 15;
+            }
+        }
+
+        written += frames;
+        cursor += frames;
+        if (cursor >= source.frameCount) {
+            if (voice.loop)
+                cursor = 0;
+            else
+                voice.active = false;
+        }
+    }
+    voice.cursor = cursor;
+}
+
+void AudioMixer::mixResampled(Voice& voice, int32_t* out, uint32_t frameCount) {
+    for (uint32_t f = 0; f < frameCount && voice.active; ++f) {
+        int32_t const t = static_cast<int32_t>(voice.frac >> 1);    // 15 bit weight, keeps the products in range
+        int32_t const left  = voice.current[0] + (((voice.next[0] - voice.current[0]) * t) >> 15);
+        int32_t const right = voice.current[1] + (((voice.next[1] - voice.current[1]) * t) >> 15);
+        out[f * 2]     += (left  * voice.gainQ15) >> 15;
+        out[f * 2 + 1] += (right * voice.gainQ15) >> 15;
+
+        voice.frac += voice.step;
+        while (voice.frac >= unitStep) {
+            voice.frac -= unitStep;
+            if (voice.exhausted) {
+                voice.active = false;
+                break;
+            }
+            std::copy_n(voice.next, 2, voice.current);
+            if (!readFrame(voice, voice.next)) {
+                std::copy_n(voice.current, 2, voice.next);
+                voice.exhausted = true;
+            }
+        }
+    }
+}
+
+bool AudioMixer::readFrame(Voice& voice, int32_t* frame) {
+    AudioSource const& source = voice.source;
+    if (voice.cursor >= source.frameCount) {
+        if (!voice.loop)
+            return false;
+        voice.cursor = 0;
+    }
+
+    const int16_t* in;
+    if (source.codec == AudioCodec::ImaAdpcm) {
+        auto const blockIndex = static_cast<int32_t>(voice.cursor / source.framesPerBlock);
+        if (blockIndex != voice.decodedBlock) {
+            ImaAdpcm::decodeBlock(source.data + static_cast<size_t>(blockIndex) * source.blockBytes,
+                                  source.blockBytes, source.channels, voice.block.data());
+            voice.decodedBlock = blockIndex;
+        }
+        in = voice.block.data() + (voice.cursor % source.framesPerBlock) * source.channels;
+    } else {
+        in = reinterpret_cast<const int16_t*>(source.data) + static_cast<size_t>(voice.cursor) * source.channels;
+    }
+
+    frame[0] = in[0];
+    frame[1] = source.channels == 2 ? in[1] : in[0];
+    ++voice.cursor;
+    return true;
+}
+
+bool AudioMixer::isPlayable(AudioSource const& source) {
+    if (source.data == nullptr || source.frameCount == 0 || source.sampleRate == 0)
+        return false;
+    if (source.channels < 1 || source.channels > 2)
+        return false;
+    if (source.codec == AudioCodec::ImaAdpcm)
+        return source.framesPerBlock > 0 && source.framesPerBlock <= maxFramesPerBlock;
+    return source.codec == AudioCodec::Pcm16;
+}
+
+int32_t AudioMixer::toQ15(float gain) {
+    return static_cast<int32_t>(std::clamp(gain, 0.f, 1.f) * 32768.f);
+}
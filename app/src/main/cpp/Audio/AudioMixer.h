@@ -0,0 +1,110 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AUDIOMIXER_H
+#define DOODLE_AUDIOMIXER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "AudioBank.h"
+#include "AudioStats.h"
+#include "../Core/SPSCQueue.h"
+
+// audio data that lives somewhere else (preloaded buffer, mapped bank..), in any supported codec and rate.
+struct AudioSource {
+    AudioCodec codec;
+    const uint8_t* data;
+    uint32_t frameCount;
+    uint32_t channels;          // 1 or 2
+    uint32_t sampleRate;
+    uint32_t blockBytes;        // adpcm only
+    uint32_t framesPerBlock;    // adpcm only
+
+    static AudioSource pcm16(const int16_t* samples, uint32_t frameCount, uint32_t channels, uint32_t sampleRate);
+    static AudioSource bankTrack(AudioBank const& bank, AudioBankTrack const& track);
+};
+
+/*!
+ * Small software mixer feeding the OpenSL buffer queue.
+ *
+ * play/stop/setGain are called from the game thread and are forwarded to the audio thread through
+ * a lock-free command ring. render() runs on the buffer queue callback, never locks or allocates,
+ * and takes the current time as a parameter so it can be driven by a fake clock on the host.
+ *
+ * Adpcm sources are decoded a block at a time straight from their (mapped) data, and sources at
+ * other rates are linearly resampled to the output rate.
+ */
+class AudioMixer {
+public:
+    static constexpr int      maxVoices         = 16;
+    static constexpr uint32_t sampleRate        = 44100;
+    static constexpr uint32_t outputChannels    = 2;
+    static constexpr uint32_t maxFramesPerCall  = 1024;
+    static constexpr uint32_t maxFramesPerBlock = 2048;
+
+    explicit AudioMixer(AudioStatsCollector& stats);
+
+    // ---- game thread ----
+    // returns the voice index that will play the source, or -1 if every voice is busy.
+    int  play(AudioSource const& source, float gain, bool loop, int64_t requestNs);
+    void stop(int voice);
+    void setGain(int voice, float gain);
+    bool isPlaying(int voice) const;
+
+    // ---- audio thread ----
+    // mixes the active voices into frameCount interleaved stereo frames.
+    void render(int16_t* output, uint32_t frameCount, int64_t nowNs);
+
+private:
+    enum class CommandType : uint8_t { Play, Stop, SetGain };
+
+    struct Command {
+        CommandType type;
+        uint8_t voice;
+        bool loop;
+        float gain;
+        AudioSource source;
+        int64_t requestNs;
+    };
+
+    struct Voice {
+        AudioSource source{};
+        uint32_t cursor{};          // next source frame to read
+        int32_t gainQ15{};
+        bool loop{};
+        bool active{};
+        bool started{};             // false until the first sample reached the output
+        bool exhausted{};           // the source ran out, the voice ends once `next` is consumed
+        int64_t requestNs{};
+
+        // resampling state, 16.16 fixed point position between `current` and `next`
+        uint32_t step{};
+        uint32_t frac{};
+        int32_t current[2]{};
+        int32_t next[2]{};
+
+        // adpcm decode state
+        int32_t decodedBlock{-1};
+        std::array<int16_t, maxFramesPerBlock * 2> block{};
+    };
+
+    void applyCommands();
+    void startVoice(Voice& voice, Command const& command);
+    void mixVoice(Voice& voice, int32_t* accumulator, uint32_t frameCount);
+    void mixDirect(Voice& voice, int32_t* accumulator, uint32_t frameCount);
+    void mixResampled(Voice& voice, int32_t* accumulator, uint32_t frameCount);
+    bool readFrame(Voice& voice, int32_t* frame);
+    static bool isPlayable(AudioSource const& source);
+    static int32_t toQ15(float gain);
+
+    AudioStatsCollector& stats;
+    SPSCQueue<Command, 64> commands;
+    std::array<Voice, maxVoices> voices;                // owned by the audio thread
+    std::array<std::atomic<bool>, maxVoices> busy{};    // set by the game thread on play, cleared by the audio thread
+    std::array<int32_t, maxFramesPerCall * outputChannels> accumulator{};
+};
+
+#endif //DOODLE_AUDIOMIXER_H
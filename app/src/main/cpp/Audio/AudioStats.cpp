@@ -0,0 +1,116 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AudioStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+void AudioStatsCollector::recordCallback(int64_t nowNs, uint32_t queuedBuffers, uint32_t totalBuffers) {
+    int64_t const previousNs = lastCallbackNs.exchange(nowNs, std::memory_order_relaxed);
+    if (previousNs >= 0 && nowNs >= previousNs) {
+        int64_t const intervalUs = (nowNs - previousNs) / 1000;
+        intervalCount.fetch_add(1, std::memory_order_relaxed);
+        intervalSumUs.fetch_add(intervalUs, std::memory_order_relaxed);
+        intervalSumSqUs.fetch_add(intervalUs * intervalUs, std::memory_order_relaxed);
+        atomicMax(intervalMaxUs, intervalUs);
+        int64_t const bucket = std::min<int64_t>(intervalUs / intervalBucketUs, intervalBuckets - 1);
+        intervalHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t const fill = totalBuffers ? (static_cast<int64_t>(queuedBuffers) * fillScale) / totalBuffers : 0;
+    fillSum.fetch_add(fill, std::memory_order_relaxed);
+    atomicMin(fillMin, fill);
+    callbackCount.fetch_add(1, std::memory_order_relaxed);
+
+    // nothing left queued, the device played silence before this callback got to run.
+    if (queuedBuffers == 0)
+        underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioStatsCollector::recordOverrun() {
+    overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioStatsCollector::recordPlayLatency(int64_t requestNs, int64_t firstSampleNs) {
+    int64_t const latencyUs = std::max<int64_t>(0, firstSampleNs - requestNs) / 1000;
+    latencyCount.fetch_add(1, std::memory_order_relaxed);
+    latencySumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    atomicMax(latencyMaxUs, latencyUs);
+}
+
+AudioStats AudioStatsCollector::snapshot() {
+    // the writers may land between two of these exchanges, which at worst moves one sample into
+    // the next window. good enough for health monitoring, and it keeps the callback lock-free.
+    uint64_t const callbacks = callbackCount.exchange(0, std::memory_order_relaxed);
+    uint64_t const intervals = intervalCount.exchange(0, std::memory_order_relaxed);
+    int64_t const sumUs      = intervalSumUs.exchange(0, std::memory_order_relaxed);
+    int64_t const sumSqUs    = intervalSumSqUs.exchange(0, std::memory_order_relaxed);
+    int64_t const maxUs      = intervalMaxUs.exchange(0, std::memory_order_relaxed);
+    int64_t const fills      = fillSum.exchange(0, std::memory_order_relaxed);
+    int64_t const minFill    = fillMin.exchange(fillScale, std::memory_order_relaxed);
+    uint32_t const latencies = latencyCount.exchange(0, std::memory_order_relaxed);
+    int64_t const latSumUs   = latencySumUs.exchange(0, std::memory_order_relaxed);
+    int64_t const latMaxUs   = latencyMaxUs.exchange(0, std::memory_order_relaxed);
+    uint32_t buckets[intervalBuckets];
+    for (int i = 0; i < intervalBuckets; ++i)
+        buckets[i] = intervalHistogram[i].exchange(0, std::memory_order_relaxed);
+
+    AudioStats stats{};
+    stats.callbackCount = callbacks;
+    if (intervals > 0) {
+        double const mean = static_cast<double>(sumUs) / intervals;
+        double const variance = std::max(0.0, static_cast<double>(sumSqUs) / intervals - mean * mean);
+        stats.callbackIntervalMeanMs = static_cast<float>(mean / 1000.0);
+        stats.callbackJitterMs       = static_cast<float>(std::sqrt(variance) / 1000.0);
+        stats.callbackIntervalMaxMs  = static_cast<float>(maxUs) / 1000.f;
+        stats.callbackIntervalP50Ms  = percentileMs(buckets, intervals, 50, maxUs);
+        stats.callbackIntervalP99Ms  = percentileMs(buckets, intervals, 99, maxUs);
+    }
+    if (callbacks > 0) {
+        stats.bufferFillMean = static_cast<float>(fills) / (callbacks * fillScale);
+        stats.bufferFillMin  = static_cast<float>(minFill) / fillScale;
+    }
+    stats.underruns = underruns.load(std::memory_order_relaxed);
+    stats.overruns  = overruns.load(std::memory_order_relaxed);
+    stats.playLatencySamples = latencies;
+    if (latencies > 0) {
+        stats.playLatencyMeanMs = static_cast<float>(latSumUs) / (latencies * 1000.f);
+        stats.playLatencyMaxMs  = static_cast<float>(latMaxUs) / 1000.f;
+    }
+    return stats;
+}
+
+void AudioStatsCollector::atomicMax(std::atomic<int64_t>& target, int64_t value) {
+    int64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+void AudioStatsCollector::atomicMin(std::atomic<int64_t>& target, int64_t value) {
+    int64_t current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+float AudioStatsCollector::percentileMs(uint32_t const* buckets, uint64_t count, uint32_t percent, int64_t maxUs) {
+    // nearest rank like LatencyHistogram, reported as the bucket's upper edge but never past the max.
+    uint64_t const rank = std::max<uint64_t>(1, (count * percent + 99) / 100);
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < intervalBuckets - 1; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank)
+            return static_cast<float>(std::min((bucket + 1) * intervalBucketUs, maxUs)) / 1000.f;
+    }
+    return static_cast<float>(maxUs) / 1000.f;
+}
+
+std::ostream& operator<<(std::ostream& os, AudioStats const& stats) {
+    return os << "Audio: callbacks " << stats.callbackCount
+              << ", interval " << stats.callbackIntervalMeanMs << "ms (p50 " << stats.callbackIntervalP50Ms
+              << "ms, p99 " << stats.callbackIntervalP99Ms << "ms, max " << stats.callbackIntervalMaxMs
+              << "ms, jitter " << stats.callbackJitterMs << "ms)"
+              << ", fill " << stats.bufferFillMean << " (min " << stats.bufferFillMin << ")"
+              << ", underruns " << stats.underruns << ", overruns " << stats.overruns
+              << ", play latency " << stats.playLatencyMeanMs << "ms (max " << stats.playLatencyMaxMs
+              << "ms, n=" << stats.playLatencySamples << ")";
+}
@@ -0,0 +1,88 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AUDIOSTATS_H
+#define DOODLE_AUDIOSTATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/*!
+ * Snapshot of the audio pipeline's health. Interval, fill and latency figures cover the window
+ * since the previous snapshot, the under/overrun counters are totals since start.
+ */
+struct AudioStats {
+    uint64_t callbackCount;             // buffer queue callbacks in this window
+    float    callbackIntervalMeanMs;
+    float    callbackIntervalMaxMs;
+    float    callbackJitterMs;          // standard deviation of the callback interval
+    float    callbackIntervalP50Ms;     // percentiles, to the interval histogram's bucket width
+    float    callbackIntervalP99Ms;
+
+    float    bufferFillMean;            // 0..1, queued buffers / total buffers seen at each callback
+    float    bufferFillMin;
+
+    uint32_t underruns;                 // callback found the queue already drained
+    uint32_t overruns;                  // producer had more data than the queue / command ring could hold
+
+    uint32_t playLatencySamples;        // play requests that reached the output in this window
+    float    playLatencyMeanMs;         // game thread request -> first sample written to the output
+    float    playLatencyMaxMs;
+};
+
+std::ostream& operator<<(std::ostream& os, AudioStats const& stats);
+
+/*!
+ * Accumulates the raw measurements behind AudioStats.
+ *
+ * The record functions are called from the audio callback threads and only touch atomics, they
+ * never lock or allocate. All timestamps are passed in by the caller (nanoseconds, any monotonic
+ * epoch) so the collector, and the mixer that feeds it, can be driven by a fake clock on the host.
+ */
+class AudioStatsCollector {
+public:
+    // called at the top of every buffer queue callback. an empty queue counts as an underrun.
+    void recordCallback(int64_t nowNs, uint32_t queuedBuffers, uint32_t totalBuffers);
+    void recordOverrun();
+    void recordPlayLatency(int64_t requestNs, int64_t firstSampleNs);
+
+    /*!
+     * Returns the stats for the window since the last call, then starts a new window.
+     * Only one thread (the engine) should take snapshots.
+     */
+    AudioStats snapshot();
+
+private:
+    static void atomicMax(std::atomic<int64_t>& target, int64_t value);
+    static void atomicMin(std::atomic<int64_t>& target, int64_t value);
+    static float percentileMs(uint32_t const* buckets, uint64_t count, uint32_t percent, int64_t maxUs);
+
+    // fill levels are stored in parts per 1024 so everything stays integral.
+    static constexpr int64_t fillScale = 1024;
+
+    // callback intervals are also binned, 250us per bucket. the last one takes everything past 32ms.
+    static constexpr int64_t intervalBucketUs = 250;
+    static constexpr int     intervalBuckets  = 128;
+
+    std::atomic<int64_t>  lastCallbackNs{-1};
+    std::atomic<uint64_t> callbackCount{0};
+    std::atomic<uint64_t> intervalCount{0};
+    std::atomic<int64_t>  intervalSumUs{0};
+    std::atomic<int64_t>  intervalSumSqUs{0};
+    std::atomic<int64_t>  intervalMaxUs{0};
+    std::atomic<uint32_t> intervalHistogram[intervalBuckets]{};
+
+    std::atomic<int64_t>  fillSum{0};
+    std::atomic<int64_t>  fillMin{fillScale};
+
+    std::atomic<uint32_t> underruns{0};
+    std::atomic<uint32_t> overruns{0};
+
+    std::atomic<uint32_t> latencyCount{0};
+    std::atomic<int64_t>  latencySumUs{0};
+    std::atomic<int64_t>  latencyMaxUs{0};
+};
+
+#endif //DOODLE_AUDIOSTATS_H
@@ -0,0 +1,120 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "ImaAdpcm.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr int16_t stepTable[89] = {
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+            50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253,
+            279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166,
+            1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428,
+            4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289,
+            16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    constexpr int8_t indexTable[16] = {
+            -1, -1, -1, -1, 2, 4, 6, 8,
+            -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    struct ChannelState {
+        int32_t predictor;
+        int32_t stepIndex;
+    };
+
+    // applies one nibble to the channel state and returns the reconstructed sample.
+    inline int16_t decodeNibble(ChannelState& state, uint8_t nibble) {
+        int32_t const step = stepTable[state.stepIndex];
+        int32_t diff = step >> 3;
+        if (nibble & 4) diff += step;
+        if (nibble & 2) diff += step >> 1;
+        if (nibble & 1) diff += step >> 2;
+        state.predictor += (nibble & 8) ? -diff : diff;
+        state.predictor = std::clamp(state.predictor, -32768, 32767);
+        state.stepIndex = std::clamp(state.stepIndex + indexTable[nibble], 0, 88);
+        return static_cast<int16_t>(state.predictor);
+    }
+
+    inline uint8_t encodeSample(ChannelState& state, int16_t sample) {
+        int32_t const step = stepTable[state.stepIndex];
+        int32_t diff = sample - state.predictor;
+        uint8_t nibble = 0;
+        if (diff < 0) {
+            nibble = 8;
+            diff = -diff;
+        }
+        if (diff >= step)            { nibble |= 4; diff -= step; }
+        if (diff >= (step >> 1))     { nibble |= 2; diff -= step >> 1; }
+        if (diff >= (step >> 2))     { nibble |= 1; }
+        // run the decoder so both sides track the same predictor.
+        decodeNibble(state, nibble);
+        return nibble;
+    }
+
+    // step index that suits the opening of a block, so the first few nibbles don't lag behind.
+    int32_t initialStepIndex(const int16_t* frames, uint32_t frameCount, uint32_t channels, uint32_t channel) {
+        if (frameCount < 2)
+            return 0;
+        int32_t const delta = std::abs(frames[channels + channel] - frames[channel]);
+        int32_t index = 0;
+        while (index < 88 && stepTable[index] < delta)
+            ++index;
+        return index;
+    }
+}
+
+void ImaAdpcm::encodeBlock(const int16_t* frames, uint32_t frameCount, uint32_t channels,
+                           uint8_t* block, uint32_t blockBytes) {
+    uint32_t const capacity = framesPerBlock(blockBytes, channels);
+    frameCount = std::min(frameCount, capacity);
+    std::memset(block, 0, blockBytes);
+
+    ChannelState states[2]{};
+    for (uint32_t c = 0; c < channels; ++c) {
+        int16_t const first = frameCount ? frames[c] : 0;
+        states[c].predictor = first;
+        states[c].stepIndex = initialStepIndex(frames, frameCount, channels, c);
+        uint8_t* header = block + c * headerBytesPerChannel;
+        header[0] = static_cast<uint8_t>(first & 0xFF);
+        header[1] = static_cast<uint8_t>((first >> 8) & 0xFF);
+        header[2] = static_cast<uint8_t>(states[c].stepIndex);
+    }
+
+    uint8_t* data = block + channels * headerBytesPerChannel;
+    uint32_t nibbleIndex = 0;
+    for (uint32_t f = 1; f < capacity; ++f) {
+        // pad a short final block by holding the last frame.
+        uint32_t const source = std::min(f, frameCount ? frameCount - 1 : 0);
+        for (uint32_t c = 0; c < channels; ++c, ++nibbleIndex) {
+            uint8_t const nibble = encodeSample(states[c], frameCount ? frames[source * channels + c] : 0);
+            data[nibbleIndex >> 1] |= (nibbleIndex & 1) ? static_cast<uint8_t>(nibble << 4) : nibble;
+        }
+    }
+}
+
+void ImaAdpcm::decodeBlock(const uint8_t* block, uint32_t blockBytes, uint32_t channels, int16_t* frames) {
+    uint32_t const capacity = framesPerBlock(blockBytes, channels);
+
+    ChannelState states[2]{};
+    for (uint32_t c = 0; c < channels; ++c) {
+        const uint8_t* header = block + c * headerBytesPerChannel;
+        states[c].predictor = static_cast<int16_t>(header[0] | (header[1] << 8));
+        states[c].stepIndex = std::min<int32_t>(header[2], 88);
+        frames[c] = static_cast<int16_t>(states[c].predictor);
+    }
+
+    const uint8_t* data = block + channels * headerBytesPerChannel;
+    uint32_t nibbleIndex = 0;
+    for (uint32_t f = 1; f < capacity; ++f) {
+        for (uint32_t c = 0; c < channels; ++c, ++nibbleIndex) {
+            uint8_t const byte = data[nibbleIndex >> 1];
+            uint8_t const nibble = (nibbleIndex & 1) ? (byte >> 4) : (byte & 0x0F);
+            frames[f * channels + c] = decodeNibble(states[c], nibble);
+        }
+    }
+}
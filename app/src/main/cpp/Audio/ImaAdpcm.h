@@ -0,0 +1,39 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_IMAADPCM_H
+#define DOODLE_IMAADPCM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * IMA-ADPCM, 4 bits per sample, in self contained blocks so any block can be decoded on its own.
+ *
+ * Block layout, per channel header first:
+ *     int16 predictor, uint8 step index, uint8 reserved          (4 bytes * channels)
+ * followed by the remaining frames as nibbles, low nibble first. Mono packs two consecutive
+ * samples per byte, stereo packs one frame (left low, right high) per byte.
+ * The header's predictor is the block's first frame, so a block holds 1 + nibble count frames.
+ */
+namespace ImaAdpcm {
+    constexpr size_t headerBytesPerChannel = 4;
+
+    // frames stored in one block of blockBytes bytes.
+    constexpr uint32_t framesPerBlock(uint32_t blockBytes, uint32_t channels) {
+        return 1 + ((blockBytes - headerBytesPerChannel * channels) * 2) / channels;
+    }
+
+    /*!
+     * Encodes frameCount interleaved frames (at most framesPerBlock) into one block of blockBytes.
+     * Short blocks are padded with the last sample.
+     */
+    void encodeBlock(const int16_t* frames, uint32_t frameCount, uint32_t channels,
+                     uint8_t* block, uint32_t blockBytes);
+
+    // decodes a full block into framesPerBlock(blockBytes, channels) interleaved frames.
+    void decodeBlock(const uint8_t* block, uint32_t blockBytes, uint32_t channels, int16_t* frames);
+}
+
+#endif //DOODLE_IMAADPCM_H
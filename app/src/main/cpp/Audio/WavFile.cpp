@@ -0,0 +1,60 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "WavFile.h"
+
+#include <cstring>
+
+namespace {
+    uint16_t readU16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t readU32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+             | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+bool parseWav(const uint8_t* data, size_t size, WavView& out) {
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+        return false;
+
+    bool hasFormat = false;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = data + offset;
+        uint32_t const chunkSize = readU32(chunk + 4);
+        const uint8_t* body = chunk + 8;
+        if (chunkSize > size - offset - 8)
+            return false;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunkSize < 16)
+                return false;
+            uint16_t const formatTag = readU16(body);
+            // 1 = integer pcm, 0xFFFE = extensible, which we only accept for plain pcm layouts.
+            if (formatTag != 1 && formatTag != 0xFFFE)
+                return false;
+            out.channels      = readU16(body + 2);
+            out.sampleRate    = readU32(body + 4);
+            out.bitsPerSample = readU16(body + 14);
+            hasFormat = out.channels > 0 && out.bitsPerSample > 0;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!hasFormat)
+                return false;
+            uint32_t const frameBytes = out.channels * (out.bitsPerSample / 8u);
+            if (frameBytes == 0)
+                return false;
+            out.samples    = body;
+            out.frameCount = chunkSize / frameBytes;
+            return true;
+        }
+
+        // chunks are word aligned.
+        offset += 8 + chunkSize + (chunkSize & 1u);
+    }
+    return false;
+}
@@ -0,0 +1,26 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_WAVFILE_H
+#define DOODLE_WAVFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// view into a RIFF/WAVE file held in memory, the samples are not copied.
+struct WavView {
+    uint16_t channels;
+    uint32_t sampleRate;
+    uint16_t bitsPerSample;
+    const uint8_t* samples;     // interleaved little endian pcm
+    uint32_t frameCount;
+};
+
+/*!
+ * Parses the fmt and data chunks of an uncompressed pcm wav file.
+ * @return false if the buffer is not a pcm wav file or is truncated.
+ */
+bool parseWav(const uint8_t* data, size_t size, WavView& out);
+
+#endif //DOODLE_WAVFILE_H
@@ -3,23 +3,59 @@
 //
 #include "AudioManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+
+#include "Audio/WavFile.h"
+#include "AndroidUtils/AndroidOut.h"
+
+namespace {
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool hasExtension(const char* path, const char* extension) {
+        size_t const pathLength = std::strlen(path);
+        size_t const extensionLength = std::strlen(extension);
+        return pathLength >= extensionLength
+            && std::strcmp(path + pathLength - extensionLength, extension) == 0;
+    }
+}
+
 AudioManager::AudioManager(android_app *pApplication):
         mAssetManager(pApplication->activity->assetManager),
         mEngineObj(nullptr),
         mEngine(nullptr),
         mOutputMixObj(nullptr),
-        mBGMPlayerObj(nullptr),
-        mBGMPlayer(nullptr),
-        mBGMPlayerSeek(nullptr)
+        mMixerPlayerObj(nullptr),
+        mMixerPlayer(nullptr),
+        mMixerQueue(nullptr),
+        mMixerNextBuffer(0),
+        mMixerBuffers{},
+        mBankAsset(nullptr),
+        mBank{},
+        mSounds{},
+        mSoundCount(0),
+        mGenerations{},
+        mMixer(mStats)
 {}
 
 AudioManager::~AudioManager() {
-    stop();
+    shutdown();
 }
 
 status AudioManager::start() {
     SLresult result;
 
+    //resources are only ever set up once
+    if(mEngineObj != nullptr){
+        return STATUS_OK;
+    }
+
     //create engine
     result = slCreateEngine(&mEngineObj, 0, nullptr, 0, nullptr, nullptr);
     if(result != SL_RESULT_SUCCESS){
@@ -50,11 +86,181 @@ status AudioManager::start() {
         return STATUS_KO;
     }
 
+    if(startMixerOutput() != STATUS_OK){
+        return STATUS_KO;
+    }
+
+    //optional, without a bank every sound is streamed from its own file
+    if(loadBank(bankPath) != STATUS_OK){
+        aout << "No audio bank, streaming sounds from loose files" << std::endl;
+    }
+    return STATUS_OK;
+}
+
+status AudioManager::loadBank(const char *path) {
+    if(mBankAsset != nullptr){
+        AAsset_close(mBankAsset);
+        mBankAsset = nullptr;
+        mBank = AudioBank{};
+    }
+
+    //AASSET_MODE_BUFFER on an uncompressed asset maps the apk instead of reading it
+    AAsset* asset = AAssetManager_open(mAssetManager, path, AASSET_MODE_BUFFER);
+    if(asset == nullptr){
+        return STATUS_KO;
+    }
+    auto* data = static_cast<const uint8_t*>(AAsset_getBuffer(asset));
+    auto const size = static_cast<size_t>(AAsset_getLength(asset));
+    if(data == nullptr || !mBank.open(data, size)){
+        aout << "Invalid audio bank " << path << std::endl;
+        AAsset_close(asset);
+        return STATUS_KO;
+    }
+    if(AAsset_isAllocated(asset)){
+        aout << "Audio bank " << path << " is compressed in the apk and was copied to memory, "
+             << "add it to noCompress" << std::endl;
+    }
+    mBankAsset = asset;
+    return STATUS_OK;
+}
+
+status AudioManager::startMixerOutput() {
+    SLresult result;
+
+    //pcm data comes from a buffer queue that the mixer refills
+    SLDataLocator_AndroidSimpleBufferQueue dataLocatorIn;
+    dataLocatorIn.locatorType = SL_DATALOCATOR_ANDROIDSIMPLEBUFFERQUEUE;
+    dataLocatorIn.numBuffers = mixerBufferCount;
+
+    //interleaved stereo 16-bit at the mixer's rate
+    SLDataFormat_PCM dataFormat;
+    dataFormat.formatType = SL_DATAFORMAT_PCM;
+    dataFormat.numChannels = AudioMixer::outputChannels;
+    dataFormat.samplesPerSec = AudioMixer::sampleRate * 1000; // in milliHertz
+    dataFormat.bitsPerSample = SL_PCMSAMPLEFORMAT_FIXED_16;
+    dataFormat.containerSize = SL_PCMSAMPLEFORMAT_FIXED_16;
+    dataFormat.channelMask = SL_SPEAKER_FRONT_LEFT | SL_SPEAKER_FRONT_RIGHT;
+    dataFormat.endianness = SL_BYTEORDER_LITTLEENDIAN;
+
+    SLDataSource dataSource;
+    dataSource.pLocator = &dataLocatorIn;
+    dataSource.pFormat = &dataFormat;
+
+    SLDataLocator_OutputMix dataLocatorOut;
+    dataLocatorOut.locatorType = SL_DATALOCATOR_OUTPUTMIX;
+    dataLocatorOut.outputMix = mOutputMixObj;
+
+    SLDataSink dataSink;
+    dataSink.pLocator = &dataLocatorOut;
+    dataSink.pFormat = nullptr;
+
+    const SLuint32 mixerPlayerIIDCount = 2;
+    const SLInterfaceID mixerPlayerIIDs[] = {
+            SL_IID_PLAY, SL_IID_ANDROIDSIMPLEBUFFERQUEUE};
+    const SLboolean mixerPlayerReqs[] =
+            {SL_BOOLEAN_TRUE, SL_BOOLEAN_TRUE};
+
+    result = (*mEngine)->CreateAudioPlayer
+            (mEngine, &mMixerPlayerObj, &dataSource, &dataSink,
+             mixerPlayerIIDCount, mixerPlayerIIDs, mixerPlayerReqs);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
+    result = (*mMixerPlayerObj)->Realize(mMixerPlayerObj, SL_BOOLEAN_FALSE);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
+    result = (*mMixerPlayerObj)->GetInterface(mMixerPlayerObj, SL_IID_PLAY, &mMixerPlayer);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
+    result = (*mMixerPlayerObj)->GetInterface(mMixerPlayerObj, SL_IID_ANDROIDSIMPLEBUFFERQUEUE, &mMixerQueue);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
+    result = (*mMixerQueue)->RegisterCallback(mMixerQueue, mixerQueueCallback, this);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
+    //prime every buffer with silence, the callback keeps the queue full from here on
+    for(uint32_t i = 0; i < mixerBufferCount; ++i){
+        std::memset(mMixerBuffers[i], 0, sizeof(mMixerBuffers[i]));
+        (*mMixerQueue)->Enqueue(mMixerQueue, mMixerBuffers[i], sizeof(mMixerBuffers[i]));
+    }
+    mMixerNextBuffer = 0;
+
+    result = (*mMixerPlayer)->SetPlayState(mMixerPlayer, SL_PLAYSTATE_PLAYING);
+    if(result != SL_RESULT_SUCCESS){
+        return STATUS_KO;
+    }
+
     return STATUS_OK;
 }
 
-void AudioManager::stop() {
-    stopBGM();
+void AudioManager::stopMixerOutput() {
+    if(mMixerPlayerObj != nullptr){
+        if(mMixerPlayer != nullptr){
+            (*mMixerPlayer)->SetPlayState(mMixerPlayer, SL_PLAYSTATE_STOPPED);
+        }
+        (*mMixerPlayerObj)->Destroy(mMixerPlayerObj);
+        mMixerPlayerObj = nullptr;
+        mMixerPlayer = nullptr;
+        mMixerQueue = nullptr;
+    }
+}
+
+void AudioManager::mixerQueueCallback(SLAndroidSimpleBufferQueueItf queue, void *context) {
+    auto& manager = *static_cast<AudioManager*>(context);
+    int64_t const now = nowNanos();
+
+    //buffers still waiting to be played, if none are left the device has been starved
+    SLAndroidSimpleBufferQueueState state{};
+    (*queue)->GetState(queue, &state);
+    manager.mStats.recordCallback(now, state.count, mixerBufferCount);
+
+    int16_t* buffer = manager.mMixerBuffers[manager.mMixerNextBuffer];
+    manager.mMixer.render(buffer, mixerBufferFrames, now);
+    manager.mMixerNextBuffer = (manager.mMixerNextBuffer + 1) % mixerBufferCount;
+
+    if((*queue)->Enqueue(queue, buffer, sizeof(manager.mMixerBuffers[0])) == SL_RESULT_BUFFER_INSUFFICIENT){
+        manager.mStats.recordOverrun();
+    }
+}
+
+void AudioManager::streamedPlayCallback(SLPlayItf player, void *context, SLuint32 event) {
+    auto& sound = *static_cast<Sound*>(context);
+    //the first head movement after a play request is the first sample leaving the player
+    if((event & SL_PLAYEVENT_HEADMOVING) && sound.latencyPending.exchange(false)){
+        sound.stats->recordPlayLatency(sound.requestNs, nowNanos());
+    }
+}
+
+AudioMixer& AudioManager::mixer() {
+    return mMixer;
+}
+
+AudioStats AudioManager::sampleStats() {
+    return mStats.snapshot();
+}
+
+void AudioManager::shutdown() {
+    for(uint16_t i = 0; i < mSoundCount; ++i){
+        destroySound(mSounds[i]);
+    }
+    mSoundCount = 0;
+    stopMixerOutput();
+
+    //only unmap the bank once the mixer can no longer read from it
+    if(mBankAsset != nullptr){
+        AAsset_close(mBankAsset);
+        mBankAsset = nullptr;
+        mBank = AudioBank{};
+    }
 
     //destroy output mix
     if(mOutputMixObj != nullptr){
@@ -83,23 +289,90 @@ ResourceDescriptor AudioManager::descriptor(const char *path) {
     return lDescriptor;
 }
 
-status AudioManager::playBGM(const char* path, bool loopBool) {
-    SLresult result;
+SoundId AudioManager::preload(const char *path) {
+    //already loaded, hand out the same id
+    for(uint16_t i = 0; i < mSoundCount; ++i){
+        if(std::strcmp(mSounds[i].path, path) == 0){
+            return SoundId{i};
+        }
+    }
+
+    if(mEngine == nullptr || mSoundCount == maxSounds || std::strlen(path) >= sizeof(Sound::path)){
+        aout << "Unable to preload sound " << path << std::endl;
+        return SoundId{};
+    }
+
+    Sound& sound = mSounds[mSoundCount];
+    std::strcpy(sound.path, path);
+    sound.descriptor = ResourceDescriptor{-1, 0, 0};
+    sound.stats = &mStats;
 
-    stopBGM();
+    //bank tracks are named after the file they were made from, minus the extension
+    char trackName[audioBankNameLength]{};
+    const char* extension = std::strrchr(path, '.');
+    std::strncpy(trackName, path, std::min<size_t>(extension ? extension - path : std::strlen(path), sizeof(trackName) - 1));
+    AudioBankTrack const* track = mBank.find(trackName);
 
-    //get ResourceDescriptor based on path
-    ResourceDescriptor descriptor = AudioManager::descriptor(path);
-    if(descriptor.mDescriptor < 0){
+    status result;
+    if(track != nullptr){
+        sound.kind = SoundKind::Bank;
+        sound.source = AudioSource::bankTrack(mBank, *track);
+        result = STATUS_OK;
+    }
+    else if(hasExtension(path, ".wav")){
+        sound.kind = SoundKind::Pcm;
+        result = loadPcm(sound);
+    }
+    else{
+        sound.kind = SoundKind::Streamed;
+        result = createStreamedPlayer(sound);
+    }
+    if(result != STATUS_OK){
+        aout << "Failed to preload sound " << path << std::endl;
+        destroySound(sound);
+        return SoundId{};
+    }
+    return SoundId{mSoundCount++};
+}
+
+status AudioManager::loadPcm(Sound& sound) {
+    AAsset* asset = AAssetManager_open(mAssetManager, sound.path, AASSET_MODE_BUFFER);
+    if(asset == nullptr){
+        return STATUS_KO;
+    }
+    sound.data.resize(AAsset_getLength(asset));
+    int const bytesRead = AAsset_read(asset, sound.data.data(), sound.data.size());
+    AAsset_close(asset);
+    if(bytesRead != static_cast<int>(sound.data.size())){
+        return STATUS_KO;
+    }
+
+    //the mixer resamples, but it only takes 16-bit mono or stereo
+    WavView wav{};
+    if(!parseWav(sound.data.data(), sound.data.size(), wav)
+       || wav.bitsPerSample != 16 || wav.channels < 1 || wav.channels > 2){
+        return STATUS_KO;
+    }
+    sound.source = AudioSource::pcm16(reinterpret_cast<const int16_t*>(wav.samples), wav.frameCount,
+                                      wav.channels, wav.sampleRate);
+    return STATUS_OK;
+}
+
+status AudioManager::createStreamedPlayer(Sound& sound) {
+    SLresult result;
+
+    //get ResourceDescriptor based on path, the descriptor stays open for the player's lifetime
+    sound.descriptor = AudioManager::descriptor(sound.path);
+    if(sound.descriptor.mDescriptor < 0){
         return STATUS_KO;
     }
 
     //specifies to the engine where to find the audio file
     SLDataLocator_AndroidFD dataLocatorIn;
     dataLocatorIn.locatorType = SL_DATALOCATOR_ANDROIDFD;
-    dataLocatorIn.fd = descriptor.mDescriptor;
-    dataLocatorIn.offset = descriptor.mStart;
-    dataLocatorIn.length = descriptor.mLength;
+    dataLocatorIn.fd = sound.descriptor.mDescriptor;
+    dataLocatorIn.offset = sound.descriptor.mStart;
+    dataLocatorIn.length = sound.descriptor.mLength;
 
     //inform the engine what kind of audio data it is dealing with
     SLDataFormat_MIME dataFormat;
@@ -123,64 +396,171 @@ status AudioManager::playBGM(const char* path, bool loopBool) {
     dataSink.pFormat = nullptr;
 
     //create OpenSL ES audio player
-    const SLuint32 bgmPlayerIIDCount = 2;
-    const SLInterfaceID bgmPlayerIIDs[] = {
-            SL_IID_PLAY, SL_IID_SEEK};
-    const SLboolean bgmPlayerReqs[] =
-            {SL_BOOLEAN_TRUE, SL_BOOLEAN_TRUE};
+    const SLuint32 playerIIDCount = 3;
+    const SLInterfaceID playerIIDs[] = {
+            SL_IID_PLAY, SL_IID_SEEK, SL_IID_VOLUME};
+    const SLboolean playerReqs[] =
+            {SL_BOOLEAN_TRUE, SL_BOOLEAN_TRUE, SL_BOOLEAN_TRUE};
 
     result = (*mEngine)->CreateAudioPlayer
-            (mEngine, &mBGMPlayerObj, &dataSource, &dataSink,
-             bgmPlayerIIDCount, bgmPlayerIIDs, bgmPlayerReqs);
+            (mEngine, &sound.playerObj, &dataSource, &dataSink,
+             playerIIDCount, playerIIDs, playerReqs);
     if(result != SL_RESULT_SUCCESS){
         return STATUS_KO;
     }
 
-    // Realize the player
-    result = (*mBGMPlayerObj)->Realize(mBGMPlayerObj, SL_BOOLEAN_FALSE);
+    // Realize the player, this is the expensive part and only happens here
+    result = (*sound.playerObj)->Realize(sound.playerObj, SL_BOOLEAN_FALSE);
     if(result != SL_RESULT_SUCCESS){
         return STATUS_KO;
     }
 
-    //get player interface (play)
-    result = (*mBGMPlayerObj)->GetInterface(mBGMPlayerObj, SL_IID_PLAY, &mBGMPlayer);
+    //get player interfaces (play, looping, gain)
+    result = (*sound.playerObj)->GetInterface(sound.playerObj, SL_IID_PLAY, &sound.player);
     if(result != SL_RESULT_SUCCESS){
         return STATUS_KO;
     }
-
-    //get player interface (looping)
-    result = (*mBGMPlayerObj)->GetInterface(mBGMPlayerObj,SL_IID_SEEK, &mBGMPlayerSeek);
+    result = (*sound.playerObj)->GetInterface(sound.playerObj, SL_IID_SEEK, &sound.seek);
     if(result != SL_RESULT_SUCCESS){
         return STATUS_KO;
     }
-
-    //configure if player should loop
-    result = (*mBGMPlayerSeek)->SetLoop(mBGMPlayerSeek, loopBool? SL_BOOLEAN_TRUE: SL_BOOLEAN_FALSE, 0, SL_TIME_UNKNOWN);
+    result = (*sound.playerObj)->GetInterface(sound.playerObj, SL_IID_VOLUME, &sound.volume);
     if(result != SL_RESULT_SUCCESS){
         return STATUS_KO;
     }
 
-    //set the player to play
-    result = (*mBGMPlayer)->SetPlayState(mBGMPlayer, SL_PLAYSTATE_PLAYING);
-    if(result != SL_RESULT_SUCCESS){
-        return STATUS_KO;
+    //report when playback actually starts moving, for the play latency stats
+    result = (*sound.player)->RegisterCallback(sound.player, streamedPlayCallback, &sound);
+    if(result == SL_RESULT_SUCCESS){
+        (*sound.player)->SetCallbackEventsMask(sound.player, SL_PLAYEVENT_HEADMOVING);
     }
 
-    return  STATUS_OK;
+    return STATUS_OK;
+}
+
+void AudioManager::destroySound(Sound &sound) {
+    if(sound.playerObj != nullptr){
+        sound.latencyPending.store(false);
+        (*sound.playerObj)->Destroy(sound.playerObj);
+    }
+    if(sound.descriptor.mDescriptor >= 0 && sound.kind == SoundKind::Streamed){
+        close(sound.descriptor.mDescriptor);
+    }
+    sound.path[0] = '\0';
+    sound.data.clear();
+    sound.data.shrink_to_fit();
+    sound.source = AudioSource{};
+    sound.descriptor = ResourceDescriptor{-1, 0, 0};
+    sound.playerObj = nullptr;
+    sound.player = nullptr;
+    sound.seek = nullptr;
+    sound.volume = nullptr;
 }
 
-void AudioManager::stopBGM() {
+VoiceHandle AudioManager::play(SoundId id, bool loop, float gain) {
+    if(!id.isValid() || id.index >= mSoundCount){
+        return VoiceHandle{};
+    }
+    Sound& sound = mSounds[id.index];
+    int64_t const requestNs = nowNanos();
 
-    //Destroy player
-    if(mBGMPlayer != nullptr){
-        SLuint32 bgmPlayerState;
-        (*mBGMPlayerObj)->GetState(mBGMPlayerObj, &bgmPlayerState);
-        if(bgmPlayerState == SL_OBJECT_STATE_REALIZED){
-            (*mBGMPlayer)->SetPlayState(mBGMPlayer, SL_PLAYSTATE_PAUSED);
-            (*mBGMPlayerObj)->Destroy(mBGMPlayerObj);
-            mBGMPlayerObj = nullptr;
-            mBGMPlayer = nullptr;
-            mBGMPlayerSeek = nullptr;
+    if(sound.kind != SoundKind::Streamed){
+        int const voice = mMixer.play(sound.source, gain, loop, requestNs);
+        if(voice < 0){
+            return VoiceHandle{};
         }
+        return VoiceHandle{static_cast<uint16_t>(voice), ++mGenerations[voice]};
+    }
+
+    //a streamed sound has a single voice, restarting it invalidates the previous handle
+    uint16_t const slot = streamedSlotBase + id.index;
+    (*sound.player)->SetPlayState(sound.player, SL_PLAYSTATE_STOPPED); // rewinds to the start
+    (*sound.seek)->SetLoop(sound.seek, loop ? SL_BOOLEAN_TRUE : SL_BOOLEAN_FALSE, 0, SL_TIME_UNKNOWN);
+    (*sound.volume)->SetVolumeLevel(sound.volume, toMillibel(gain));
+    sound.requestNs = requestNs;
+    sound.latencyPending.store(true);
+    if((*sound.player)->SetPlayState(sound.player, SL_PLAYSTATE_PLAYING) != SL_RESULT_SUCCESS){
+        sound.latencyPending.store(false);
+        return VoiceHandle{};
+    }
+    return VoiceHandle{slot, ++mGenerations[slot]};
+}
+
+void AudioManager::stop(VoiceHandle voice) {
+    if(!isAlive(voice)){
+        return;
+    }
+    if(voice.slot < streamedSlotBase){
+        mMixer.stop(voice.slot);
+    }
+    else{
+        Sound& sound = mSounds[voice.slot - streamedSlotBase];
+        sound.latencyPending.store(false);
+        (*sound.player)->SetPlayState(sound.player, SL_PLAYSTATE_STOPPED);
+    }
+    //retire the handle
+    ++mGenerations[voice.slot];
+}
+
+void AudioManager::setGain(VoiceHandle voice, float gain) {
+    if(!isAlive(voice)){
+        return;
+    }
+    if(voice.slot < streamedSlotBase){
+        mMixer.setGain(voice.slot, gain);
+    }
+    else{
+        Sound& sound = mSounds[voice.slot - streamedSlotBase];
+        (*sound.volume)->SetVolumeLevel(sound.volume, toMillibel(gain));
+    }
+}
+
+bool AudioManager::isPlaying(VoiceHandle voice) const {
+    if(!isAlive(voice)){
+        return false;
+    }
+    if(voice.slot < streamedSlotBase){
+        return mMixer.isPlaying(voice.slot);
+    }
+    Sound const& sound = mSounds[voice.slot - streamedSlotBase];
+    SLuint32 state = SL_PLAYSTATE_STOPPED;
+    (*sound.player)->GetPlayState(sound.player, &state);
+    return state == SL_PLAYSTATE_PLAYING;
+}
+
+void AudioManager::setPaused(bool paused) {
+    // the mixer's queue keeps its buffers, it picks up with the one it was playing.
+    if(mMixerPlayer != nullptr){
+        (*mMixerPlayer)->SetPlayState(mMixerPlayer, paused ? SL_PLAYSTATE_PAUSED : SL_PLAYSTATE_PLAYING);
+    }
+    // stop() only ever stops, so a paused streamed player is one paused here.
+    SLuint32 const from = paused ? SL_PLAYSTATE_PLAYING : SL_PLAYSTATE_PAUSED;
+    for(uint16_t i = 0; i < mSoundCount; ++i){
+        Sound& sound = mSounds[i];
+        if(sound.kind != SoundKind::Streamed || sound.player == nullptr){
+            continue;
+        }
+        SLuint32 state = SL_PLAYSTATE_STOPPED;
+        (*sound.player)->GetPlayState(sound.player, &state);
+        if(state == from){
+            (*sound.player)->SetPlayState(sound.player, paused ? SL_PLAYSTATE_PAUSED : SL_PLAYSTATE_PLAYING);
+        }
+    }
+}
+
+bool AudioManager::isAlive(VoiceHandle voice) const {
+    if(!voice.isValid() || voice.slot >= mGenerations.size()){
+        return false;
+    }
+    if(voice.slot >= streamedSlotBase && voice.slot - streamedSlotBase >= mSoundCount){
+        return false;
+    }
+    return mGenerations[voice.slot] == voice.generation;
+}
+
+SLmillibel AudioManager::toMillibel(float gain) {
+    if(gain <= 0.0001f){
+        return SL_MILLIBEL_MIN;
     }
+    return static_cast<SLmillibel>(std::clamp(2000.f * std::log10(gain), -9600.f, 0.f));
 }
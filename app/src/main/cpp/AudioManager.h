@@ -5,13 +5,21 @@
 #ifndef DOODLE_AUDIOMANAGER_H
 #define DOODLE_AUDIOMANAGER_H
 
+#include <array>
+#include <atomic>
 #include <stdint.h>
+#include <vector>
 #include <sys/types.h>
 #include <SLES/OpenSLES.h>
 #include <android/asset_manager.h>
 #include <SLES/OpenSLES_Android.h>
 #include <game-activity/native_app_glue/android_native_app_glue.h>
 
+#include "Audio/AudioBank.h"
+#include "Audio/AudioHandles.h"
+#include "Audio/AudioMixer.h"
+#include "Audio/AudioStats.h"
+
 struct android_app;
 
 enum status{
@@ -25,44 +33,147 @@ struct ResourceDescriptor{
     off_t mLength;
 };
 
+/*!
+ * Owns the OpenSL engine, the output mix and every preloaded sound.
+ *
+ * There must only be one of these (it is not copyable), resources are set up once in start() and
+ * preload(), after which play/stop/setGain only flip state on already realized objects.
+ *
+ * Sounds come in three kinds, looked up in this order:
+ *  - tracks of the audio bank (see Audio/AudioBank.h), keyed by the path without its extension.
+ *    The bank is mapped once and decoded straight from the mapping by the software mixer.
+ *  - wav files, loaded into memory and also played through the mixer.
+ *  - anything else is streamed from the apk by its own OpenSL player (one voice per sound,
+ *    replaying it restarts the sound). This is the fallback when no bank is packaged.
+ */
 class AudioManager{
 public:
+    static constexpr uint16_t maxSounds = 32;
+    static constexpr const char* bankPath = "audio.bank";
+
     /*!
     * AudioManager constructor, initializes required variables
     */
     AudioManager(android_app* pApplication);
     /*!
-    * AudioManager destructor, calls stop()
+    * AudioManager destructor, calls shutdown()
     */
     ~AudioManager();
+
+    AudioManager(AudioManager const&) = delete;
+    AudioManager& operator=(AudioManager const&) = delete;
+
     /*!
     * Returns the ResourceDescriptor that points to chosen file
     */
     ResourceDescriptor descriptor(const char* path);
     /*!
-    * Initialize the OpenSL engine, output mixer, audio players
+    * Initialize the OpenSL engine, output mixer and the mixer's buffer queue player, and mount the
+    * audio bank if the apk has one
     */
     status start();
     /*!
-    * Stop BGM
+    * Map the bank at path, its tracks take priority over loose files in preload()
+    */
+    status loadBank(const char* path);
+    /*!
+    * Destroy every player, the output mix and the engine
+    */
+    void shutdown();
+    /*!
+    * Load (once) the sound at path, returns the same id for the same path
+    */
+    SoundId preload(const char* path);
+    /*!
+    * Start a new voice of the sound, returns an invalid handle if there is no voice free
+    */
+    VoiceHandle play(SoundId sound, bool loop = false, float gain = 1.f);
+    /*!
+    * Stop the voice, stale handles are ignored
+    */
+    void stop(VoiceHandle voice);
+    /*!
+    * Set the voice's linear gain, 0 to 1
     */
-    void stop();
+    void setGain(VoiceHandle voice, float gain);
+    bool isPlaying(VoiceHandle voice) const;
     /*!
-    * play BGM with the given filename
+    * Pause or resume all output, for the app going to the background and back. Voices carry on
+    * where they were, a voice stopped in between stays stopped
     */
-    status playBGM(const char* path, bool loopBool);
+    void setPaused(bool paused);
     /*!
-    * Stop BGM and destroy player
+    * Mixer feeding the buffer queue output, for in-memory pcm
     */
-    void stopBGM();
+    AudioMixer& mixer();
+    /*!
+    * Takes the audio health stats gathered since the previous call
+    */
+    AudioStats sampleStats();
 private:
+    enum class SoundKind : uint8_t{
+        Bank,
+        Pcm,
+        Streamed
+    };
+
+    struct Sound{
+        char path[64];
+        SoundKind kind;
+
+        // mixer sounds (bank and wav). wav files stay in data and the source points into it
+        std::vector<uint8_t> data;
+        AudioSource source;
+
+        // streamed sounds
+        ResourceDescriptor descriptor;
+        SLObjectItf playerObj;
+        SLPlayItf player;
+        SLSeekItf seek;
+        SLVolumeItf volume;
+        int64_t requestNs;
+        std::atomic<bool> latencyPending;
+        AudioStatsCollector* stats;
+    };
+
+    status loadPcm(Sound& sound);
+    status createStreamedPlayer(Sound& sound);
+    void destroySound(Sound& sound);
+    bool isAlive(VoiceHandle voice) const;
+    /*!
+    * Create the pcm buffer queue player that the mixer renders into
+    */
+    status startMixerOutput();
+    void stopMixerOutput();
+    static void mixerQueueCallback(SLAndroidSimpleBufferQueueItf queue, void* context);
+    static void streamedPlayCallback(SLPlayItf player, void* context, SLuint32 event);
+    static SLmillibel toMillibel(float gain);
+
+    static constexpr uint32_t mixerBufferCount = 2;
+    static constexpr uint32_t mixerBufferFrames = 256;
+    // voice slots [0, maxVoices) are mixer voices, the rest map one to one onto the streamed sounds.
+    static constexpr uint16_t streamedSlotBase = AudioMixer::maxVoices;
+
     AAssetManager* mAssetManager;
     SLObjectItf mEngineObj;
     SLEngineItf mEngine;
     SLObjectItf mOutputMixObj;
 
-    SLObjectItf mBGMPlayerObj;
-    SLPlayItf mBGMPlayer;
-    SLSeekItf mBGMPlayerSeek;
+    SLObjectItf mMixerPlayerObj;
+    SLPlayItf mMixerPlayer;
+    SLAndroidSimpleBufferQueueItf mMixerQueue;
+    uint32_t mMixerNextBuffer;
+    int16_t mMixerBuffers[mixerBufferCount][mixerBufferFrames * AudioMixer::outputChannels];
+
+    // the bank asset stays open (and mapped) for the manager's lifetime
+    AAsset* mBankAsset;
+    AudioBank mBank;
+
+    std::array<Sound, maxSounds> mSounds;
+    uint16_t mSoundCount;
+    std::array<uint16_t, streamedSlotBase + maxSounds> mGenerations;
+
+    AudioStatsCollector mStats;
+    AudioMixer mMixer;
 };
 #endif //DOODLE_AUDIOMANAGER_H
@@ -0,0 +1,94 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AllocationTracker.h"
+
+#ifdef DOODLE_TRACK_ALLOCATIONS
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+namespace {
+    thread_local uint64_t allocations = 0;
+
+    void* allocate(std::size_t size) {
+        ++allocations;
+        if (void* memory = std::malloc(size != 0 ? size : 1))
+            return memory;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        ++allocations;
+        std::size_t const align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+        void* memory = nullptr;
+        if (posix_memalign(&memory, align, size != 0 ? size : 1) == 0)
+            return memory;
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t AllocationTracker::threadAllocations() {
+    return allocations;
+}
+
+NoAllocationScope::NoAllocationScope(const char* what) :
+        what { what },
+        start { allocations }
+{}
+
+NoAllocationScope::~NoAllocationScope() {
+    uint64_t const made = allocations - start;
+    if (made == 0)
+        return;
+
+    // fatal in every build type. written straight out rather than through the log ring, which may
+    // have no writer thread (tools/headless) and would lose the line when we abort.
+    char text[128];
+    std::snprintf(text, sizeof(text), "%s made %llu heap allocations", what, static_cast<unsigned long long>(made));
+#ifdef __ANDROID__
+    __android_log_write(ANDROID_LOG_FATAL, "DoodleAlloc", text);
+#else
+    std::fprintf(stderr, "DoodleAlloc: %s\n", text);
+#endif
+    std::abort();
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+    ++allocations;
+    return std::malloc(size != 0 ? size : 1);
+}
+void* operator new[](std::size_t size, std::nothrow_t const& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::nothrow_t const&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::nothrow_t const&) noexcept { std::free(memory); }
+
+#else
+
+uint64_t AllocationTracker::threadAllocations() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,41 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_ALLOCATIONTRACKER_H
+#define DOODLE_ALLOCATIONTRACKER_H
+
+#include <cstdint>
+
+/*!
+ * Debug aid for keeping the heap out of the frame loop.
+ *
+ * Built with DOODLE_TRACK_ALLOCATIONS defined, the global operator new/delete are replaced with
+ * versions that count allocations per thread, and a NoAllocationScope aborts, in release builds
+ * too, when the thread allocated while it was alive. Without it, both compile to nothing. The
+ * define comes from the DOODLE_TRACK_ALLOCATIONS CMake option of the app and of tools/.
+ */
+namespace AllocationTracker {
+    // allocations made by the calling thread so far, always 0 when tracking is off.
+    uint64_t threadAllocations();
+}
+
+class NoAllocationScope {
+public:
+#ifdef DOODLE_TRACK_ALLOCATIONS
+    explicit NoAllocationScope(const char* what);
+    ~NoAllocationScope();
+
+private:
+    const char* what;
+    uint64_t    start;
+#else
+    explicit NoAllocationScope(const char*) {}
+#endif
+
+public:
+    NoAllocationScope(NoAllocationScope const&) = delete;
+    NoAllocationScope& operator=(NoAllocationScope const&) = delete;
+};
+
+#endif //DOODLE_ALLOCATIONTRACKER_H
@@ -0,0 +1,34 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_CLOCK_H
+#define DOODLE_CLOCK_H
+
+#include <cstdint>
+#include <time.h>
+
+/*!
+ * The engine's time base is CLOCK_MONOTONIC in nanoseconds, the same clock as std::chrono::steady_clock
+ * and the motion event times GameActivity hands us. Sensor events are stamped with CLOCK_BOOTTIME
+ * instead, which keeps running during suspend, so they are converted before being compared.
+ */
+namespace Clock {
+    inline int64_t read(clockid_t clock) {
+        timespec now{};
+        clock_gettime(clock, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+    }
+
+    inline int64_t monotonicNs() { return read(CLOCK_MONOTONIC); }
+    inline int64_t boottimeNs() { return read(CLOCK_BOOTTIME); }
+
+    // the offset between both clocks only grows while the device sleeps, so taking it now is exact
+    // for anything that happened since the last wake up.
+    inline int64_t boottimeToMonotonicNs(int64_t boottimeNs) {
+        int64_t const monotonic = monotonicNs();
+        return boottimeNs - (Clock::boottimeNs() - monotonic);
+    }
+}
+
+#endif //DOODLE_CLOCK_H
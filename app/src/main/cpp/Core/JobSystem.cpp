@@ -0,0 +1,210 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "JobSystem.h"
+
+#include <cstdio>
+#include <pthread.h>
+
+namespace {
+    // yields before an idle worker goes to sleep, enough to bridge the gap between two batches of
+    // one frame without keeping cores busy between frames.
+    constexpr unsigned spinsBeforeSleep = 64;
+
+    struct CurrentThread {
+        JobSystem const* system = nullptr;
+        int              index  = -1;
+    };
+    thread_local CurrentThread current;
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    unsigned const cores = std::thread::hardware_concurrency();
+    return cores > 1 ? std::min(cores - 1, maxWorkers) : 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    workerCount = std::min(workerCount, maxWorkers);
+    threads.reserve(workerCount + 1);
+    for (unsigned i = 0; i <= workerCount; ++i)
+        threads.push_back(std::make_unique<Thread>());
+    current = CurrentThread{this, 0};
+    workers.reserve(workerCount);
+    for (unsigned i = 1; i <= workerCount; ++i)
+        workers.emplace_back([this, i] { workerMain(i); });
+}
+
+JobSystem::~JobSystem() {
+    running.store(false, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock{sleepMutex}; }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    if (current.system == this)
+        current = CurrentThread{};
+}
+
+int JobSystem::currentThread() const {
+    return current.system == this ? current.index : -1;
+}
+
+void JobSystem::run(JobFunction function, void* context, JobCounter& counter, std::size_t begin, std::size_t end) {
+    int const self = currentThread();
+    if (self < 0 || workers.empty()) {
+        function(context, begin, end);
+        return;
+    }
+    Job* job = allocate(*threads[static_cast<std::size_t>(self)], function, context, begin, end, counter);
+    submit(*threads[static_cast<std::size_t>(self)], job);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, JobFunction function, void* context, JobCounter& counter,
+                         std::size_t begin, std::size_t end) {
+    int const self = currentThread();
+    if (self < 0 || workers.empty()) {
+        wait(dependency);
+        function(context, begin, end);
+        return;
+    }
+    Job* job = allocate(*threads[static_cast<std::size_t>(self)], function, context, begin, end, counter);
+    {
+        std::lock_guard<std::mutex> lock{dependency.mutex};
+        if (dependency.pending.load(std::memory_order_acquire) != 0) {
+            // queued by whichever thread finishes the dependency's last job.
+            job->nextWaiting = dependency.waiting;
+            dependency.waiting = job;
+            return;
+        }
+    }
+    submit(*threads[static_cast<std::size_t>(self)], job);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    int const self = currentThread();
+    while (!counter.done()) {
+        if (self < 0 || !helpOnce(static_cast<std::size_t>(self)))
+            std::this_thread::yield();
+    }
+    // the last job may still be releasing the counter's dependents, the caller may drop the counter
+    // as soon as this returns.
+    { std::lock_guard<std::mutex> lock{counter.mutex}; }
+}
+
+JobSystem::Job* JobSystem::allocate(Thread& thread, JobFunction function, void* context,
+                                    std::size_t begin, std::size_t end, JobCounter& counter) {
+    for (;;) {
+        for (std::size_t tries = 0; tries < jobsPerThread; ++tries) {
+            Job& job = thread.jobs[thread.nextJob];
+            thread.nextJob = (thread.nextJob + 1) & (jobsPerThread - 1);
+            if (!job.free.load(std::memory_order_acquire))
+                continue;
+            job.free.store(false, std::memory_order_relaxed);
+            job.function = function;
+            job.context = context;
+            job.begin = begin;
+            job.end = end;
+            job.counter = &counter;
+            job.nextWaiting = nullptr;
+            counter.pending.fetch_add(1, std::memory_order_relaxed);
+            return &job;
+        }
+        // every slot in flight, get some of them done.
+        if (!helpOnce(static_cast<std::size_t>(currentThread())))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::submit(Thread& thread, Job* job) {
+    if (!thread.deque.push(job)) {
+        execute(job);
+        return;
+    }
+    // pairs with the fence in workerMain, either the sleeper sees the job or this sees the sleeper.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) != 0) {
+        { std::lock_guard<std::mutex> lock{sleepMutex}; }
+        wake.notify_one();
+    }
+}
+
+void JobSystem::execute(Job* job) {
+    job->function(job->context, job->begin, job->end);
+    JobCounter& counter = *job->counter;
+    job->free.store(true, std::memory_order_release);
+
+    uint32_t pending = counter.pending.load(std::memory_order_relaxed);
+    while (pending > 1) {
+        if (counter.pending.compare_exchange_weak(pending, pending - 1, std::memory_order_release, std::memory_order_relaxed))
+            return;
+    }
+    // possibly the last one, which has to hand over the dependents before anyone sees it done.
+    Job* released;
+    {
+        std::lock_guard<std::mutex> lock{counter.mutex};
+        if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        released = counter.waiting;
+        counter.waiting = nullptr;
+    }
+    // the counter may be gone by now, only its dependents are touched.
+    Thread& thread = *threads[static_cast<std::size_t>(currentThread())];
+    while (released) {
+        Job* next = released->nextWaiting;
+        submit(thread, released);
+        released = next;
+    }
+}
+
+JobSystem::Job* JobSystem::findJob(std::size_t self) {
+    if (Job* job = threads[self]->deque.pop())
+        return job;
+    std::size_t const count = threads.size();
+    for (std::size_t i = 1; i < count; ++i) {
+        if (Job* job = threads[(self + i) % count]->deque.steal())
+            return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::helpOnce(std::size_t self) {
+    Job* job = findJob(self);
+    if (!job)
+        return false;
+    execute(job);
+    return true;
+}
+
+bool JobSystem::anyQueued() const {
+    for (auto const& thread : threads) {
+        if (!thread->deque.empty())
+            return true;
+    }
+    return false;
+}
+
+void JobSystem::workerMain(std::size_t self) {
+    current = CurrentThread{this, static_cast<int>(self)};
+    char name[16];
+    std::snprintf(name, sizeof(name), "DoodleJob%zu", self);
+    pthread_setname_np(pthread_self(), name);
+
+    unsigned idle = 0;
+    while (running.load(std::memory_order_acquire)) {
+        if (helpOnce(self)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < spinsBeforeSleep) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+        std::unique_lock<std::mutex> lock{sleepMutex};
+        sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (running.load(std::memory_order_acquire) && !anyQueued())
+            wake.wait(lock);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,167 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_JOBSYSTEM_H
+#define DOODLE_JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingDeque.h"
+
+class JobSystem;
+
+// a job's work, on the [begin, end) it was queued with.
+using JobFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+/*!
+ * Counts the unfinished jobs queued against it: run() adds one, a job finishing takes one off.
+ * JobSystem::wait() helps until it reaches zero, and jobs queued with runAfter() start once it does.
+ *
+ * Reusable once it's done. It must outlive its jobs, which a wait() on it guarantees.
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(JobCounter const&) = delete;
+    JobCounter& operator=(JobCounter const&) = delete;
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    struct Job;
+
+    std::atomic<uint32_t> pending{0};
+    // the last job finishing takes `waiting` under the lock, so a dependent job is never left behind.
+    std::mutex mutex;
+    Job*       waiting{nullptr};
+};
+
+/*!
+ * Work stealing jobs for the engine: one worker per core besides the thread that created the system
+ * (the owner, the game thread on a device), each with a Chase-Lev deque (see WorkStealingDeque.h).
+ *
+ * A thread queues on its own deque and works through it newest first, idle threads steal the
+ * oldest jobs of the others. The owner isn't a worker, it runs jobs while it waits on a counter, so
+ * parallelFor() never leaves it idle. Workers spin for a moment when they run out of work and then
+ * sleep until something is queued.
+ *
+ * Jobs are a function pointer and a context, kept in a fixed ring per thread, so queueing never
+ * allocates. A thread has at most jobsPerThread jobs in flight, queueing more helps out until a
+ * slot frees up.
+ *
+ * Only the owner and the workers may queue. From any other thread, and always with no workers,
+ * run() just runs the job.
+ */
+class JobSystem {
+public:
+    static constexpr std::size_t jobsPerThread = 1024;
+
+    // one per core besides the owner, at most maxWorkers.
+    static unsigned defaultWorkerCount();
+    static constexpr unsigned maxWorkers = 15;
+
+    explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+    // every job must be done.
+    ~JobSystem();
+
+    JobSystem(JobSystem const&) = delete;
+    JobSystem& operator=(JobSystem const&) = delete;
+
+    void run(JobFunction function, void* context, JobCounter& counter, std::size_t begin = 0, std::size_t end = 0);
+    // queued now and counted on `counter` right away, but only started once `dependency` is done.
+    void runAfter(JobCounter& dependency, JobFunction function, void* context, JobCounter& counter,
+                  std::size_t begin = 0, std::size_t end = 0);
+    // runs queued jobs until `counter` is done.
+    void wait(JobCounter& counter);
+
+    // body(first, last) over [begin, end) in chunks of at least `grain`, the calling thread takes
+    // the first one. returns when all of them are done, a range of less than two chunks just runs
+    // inline.
+    template <typename Body>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body const& body);
+
+    // workers plus the owner.
+    unsigned getThreadCount() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    using Job = JobCounter::Job;
+    struct Thread;
+
+    // a few chunks per thread, so a thread that's late to start doesn't hold up the rest.
+    static constexpr std::size_t chunksPerThread = 4;
+
+    template <typename Body>
+    static void runBody(void* context, std::size_t begin, std::size_t end) {
+        (*static_cast<Body const*>(context))(begin, end);
+    }
+
+    // the calling thread's index in `threads`, -1 when it isn't one of them.
+    int currentThread() const;
+    // a free slot of the thread's ring, filled in and counted on `counter`.
+    Job* allocate(Thread& thread, JobFunction function, void* context, std::size_t begin, std::size_t end,
+                  JobCounter& counter);
+    void submit(Thread& thread, Job* job);
+    void execute(Job* job);
+    // pops from the own deque, then steals from the others. nullptr when there's nothing.
+    Job* findJob(std::size_t self);
+    // runs one job, false when there was none.
+    bool helpOnce(std::size_t self);
+    bool anyQueued() const;
+    void workerMain(std::size_t self);
+
+    std::vector<std::unique_ptr<Thread>> threads;    // the owner first, then the workers
+    std::vector<std::thread>             workers;
+
+    std::mutex              sleepMutex;
+    std::condition_variable wake;
+    std::atomic<uint32_t>   sleepers{0};
+    std::atomic<bool>       running{true};
+};
+
+struct JobCounter::Job {
+    JobFunction  function;
+    void*        context;
+    std::size_t  begin;
+    std::size_t  end;
+    JobCounter*  counter;
+    Job*         nextWaiting;
+    std::atomic<bool> free{true};    // the ring slot can be reused
+};
+
+struct JobSystem::Thread {
+    WorkStealingDeque<Job, jobsPerThread> deque;
+    std::unique_ptr<Job[]> jobs{new Job[jobsPerThread]};
+    std::size_t nextJob{0};
+};
+
+template <typename Body>
+void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body const& body) {
+    if (begin >= end)
+        return;
+    std::size_t const count = end - begin;
+    std::size_t const chunks = std::min((count + std::max<std::size_t>(grain, 1) - 1) / std::max<std::size_t>(grain, 1),
+                                        threads.size() * chunksPerThread);
+    if (chunks < 2 || workers.empty()) {
+        body(begin, end);
+        return;
+    }
+    std::size_t const step = (count + chunks - 1) / chunks;
+    JobCounter counter;
+    void* const context = const_cast<void*>(static_cast<void const*>(&body));
+    for (std::size_t first = begin + step; first < end; first += step)
+        run(&runBody<Body>, context, counter, first, std::min(end, first + step));
+    body(begin, begin + step);
+    wait(counter);
+}
+
+#endif //DOODLE_JOBSYSTEM_H
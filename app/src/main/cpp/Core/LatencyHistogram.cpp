@@ -0,0 +1,54 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+
+std::ostream& operator<<(std::ostream& out, LatencySummary const& summary) {
+    return out << "n=" << summary.count
+               << " p50=" << summary.p50Ms << "ms"
+               << " p90=" << summary.p90Ms << "ms"
+               << " p99=" << summary.p99Ms << "ms"
+               << " max=" << summary.maxMs << "ms";
+}
+
+void LatencyHistogram::record(int64_t latencyNs) {
+    latencyNs = std::max<int64_t>(latencyNs, 0);
+    int64_t const bucket = std::min<int64_t>(latencyNs / bucketWidthNs, bucketCount);
+    ++buckets[bucket];
+    ++count;
+    maxNs = std::max(maxNs, latencyNs);
+}
+
+LatencySummary LatencyHistogram::summarize() const {
+    if (count == 0)
+        return LatencySummary{};
+    // nearest rank, the n-th sample in sorted order is at rank ceil(p * n).
+    auto rank = [this](uint32_t percent) { return std::max<uint32_t>(1, (count * percent + 99) / 100); };
+    return LatencySummary{
+            count,
+            percentileMs(rank(50)),
+            percentileMs(rank(90)),
+            percentileMs(rank(99)),
+            static_cast<float>(maxNs) * 1e-6f
+    };
+}
+
+void LatencyHistogram::reset() {
+    buckets.fill(0);
+    count = 0;
+    maxNs = 0;
+}
+
+float LatencyHistogram::percentileMs(uint32_t rank) const {
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < bucketCount; ++bucket) {
+        seen += buckets[bucket];
+        // report the upper edge of the bucket, never more than what was actually measured.
+        if (seen >= rank)
+            return static_cast<float>(std::min((bucket + 1) * bucketWidthNs, maxNs)) * 1e-6f;
+    }
+    return static_cast<float>(maxNs) * 1e-6f;
+}
@@ -0,0 +1,43 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_LATENCYHISTOGRAM_H
+#define DOODLE_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+struct LatencySummary {
+    uint32_t count;
+    float p50Ms;
+    float p90Ms;
+    float p99Ms;
+    float maxMs;
+};
+
+std::ostream& operator<<(std::ostream& out, LatencySummary const& summary);
+
+/*!
+ * Fixed bucket latency histogram, 0.5 ms buckets up to 100 ms and one overflow bucket. Recording
+ * is a single increment, percentiles are read off the buckets so they are accurate to a bucket.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int64_t bucketWidthNs = 500'000;
+    static constexpr int     bucketCount   = 200;
+
+    void record(int64_t latencyNs);
+    LatencySummary summarize() const;
+    void reset();
+
+private:
+    float percentileMs(uint32_t rank) const;
+
+    std::array<uint32_t, bucketCount + 1> buckets{};    // last one holds everything past the range
+    uint32_t count = 0;
+    int64_t maxNs = 0;
+};
+
+#endif //DOODLE_LATENCYHISTOGRAM_H
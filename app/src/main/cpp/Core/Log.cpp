@@ -0,0 +1,406 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+#include "Clock.h"
+
+namespace Log {
+namespace {
+    using detail::ArgType;
+    using detail::Record;
+
+    // how long the writer sleeps when there is nothing to write.
+    constexpr auto idleWait = std::chrono::milliseconds(2);
+
+    /*!
+     * Bounded multi-producer ring (Vyukov): every slot carries a sequence number telling whether it
+     * is free for the producer at a given position or holds a record for the consumer. Producers
+     * claim a position with one CAS and publish by bumping the slot's sequence.
+     */
+    class Ring {
+    public:
+        static constexpr std::size_t mask = detail::recordCount - 1;
+        static_assert((detail::recordCount & mask) == 0, "record count must be a power of two");
+
+        Ring() {
+            for (std::size_t i = 0; i < detail::recordCount; ++i)
+                records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        Record* claim() {
+            std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            for (;;) {
+                Record& record = records[position & mask];
+                std::size_t const sequence = record.sequence.load(std::memory_order_acquire);
+                auto const difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        return &record;
+                } else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static void publish(Record* record, std::size_t position) {
+            record->sequence.store(position + 1, std::memory_order_release);
+        }
+
+        // consumer only, returns null when the next record isn't published yet.
+        Record* peek() {
+            Record& record = records[dequeuePosition & mask];
+            if (record.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+                return nullptr;
+            return &record;
+        }
+
+        void release(Record* record) {
+            record->sequence.store(dequeuePosition + detail::recordCount, std::memory_order_release);
+            ++dequeuePosition;
+        }
+
+        // records handed out so far, the ones dropped for lack of room don't count.
+        std::size_t claimed() const { return enqueuePosition.load(std::memory_order_acquire); }
+
+        std::atomic<uint32_t> dropped{0};
+
+    private:
+        alignas(64) std::atomic<std::size_t> enqueuePosition{0};
+        alignas(64) std::size_t dequeuePosition = 0;
+        std::array<Record, detail::recordCount> records;
+    };
+
+    Ring& ring() {
+        static Ring instance;
+        return instance;
+    }
+
+    struct Writer {
+        std::thread thread;
+        std::atomic<bool> running{false};
+        std::atomic<std::size_t> written{0};
+    };
+
+    Writer writer;
+
+    uint32_t currentThreadId() {
+        static thread_local auto const id = static_cast<uint32_t>(syscall(SYS_gettid));
+        return id;
+    }
+
+    // ---- formatting, writer thread only ----
+
+    struct Arg {
+        ArgType type;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            struct { const char* data; uint16_t length; } s;
+        };
+    };
+
+    class ArgReader {
+    public:
+        explicit ArgReader(Record const& record) :
+                at { record.payload },
+                end { record.payload + record.payloadBytes }
+        {}
+
+        bool next(Arg& arg) {
+            if (at >= end)
+                return false;
+            arg.type = static_cast<ArgType>(*at++);
+            switch (arg.type) {
+                case ArgType::String:
+                    std::memcpy(&arg.s.length, at, sizeof(uint16_t));
+                    arg.s.data = reinterpret_cast<const char*>(at + sizeof(uint16_t));
+                    at += sizeof(uint16_t) + arg.s.length;
+                    return true;
+                default:
+                    std::memcpy(&arg.u, at, sizeof(uint64_t));
+                    at += sizeof(uint64_t);
+                    return true;
+            }
+        }
+
+    private:
+        const uint8_t* at;
+        const uint8_t* end;
+    };
+
+    class LineBuilder {
+    public:
+        void append(const char* text, std::size_t length) {
+            std::size_t const room = sizeof(line) - 1 - size;
+            length = std::min(length, room);
+            std::memcpy(line + size, text, length);
+            size += length;
+            line[size] = '\0';
+        }
+
+        template <typename... Values>
+        void appendFormatted(const char* spec, Values... values) {
+            std::size_t const room = sizeof(line) - size;
+            int const written = std::snprintf(line + size, room, spec, values...);
+            if (written > 0)
+                size += std::min<std::size_t>(static_cast<std::size_t>(written), room - 1);
+        }
+
+        const char* c_str() const { return line; }
+        void clear() { size = 0; line[0] = '\0'; }
+
+    private:
+        char line[1024] = {};
+        std::size_t size = 0;
+    };
+
+    int64_t asInt(Arg const& arg) {
+        return arg.type == ArgType::Double ? static_cast<int64_t>(arg.d) : arg.i;
+    }
+
+    uint64_t asUInt(Arg const& arg) {
+        return arg.type == ArgType::Double ? static_cast<uint64_t>(arg.d) : arg.u;
+    }
+
+    double asDouble(Arg const& arg) {
+        switch (arg.type) {
+            case ArgType::Double: return arg.d;
+            case ArgType::Int:    return static_cast<double>(arg.i);
+            default:              return static_cast<double>(arg.u);
+        }
+    }
+
+    // formats one conversion, spec is the %.. text without any length modifier.
+    void formatArg(LineBuilder& out, std::string& spec, char conversion, Arg const& arg) {
+        switch (conversion) {
+            case 'c':
+                spec += conversion;
+                out.appendFormatted(spec.c_str(), static_cast<int>(asInt(arg)));
+                return;
+            case 'd': case 'i':
+                spec += "lld";
+                out.appendFormatted(spec.c_str(), static_cast<long long>(asInt(arg)));
+                return;
+            case 'u': case 'x': case 'X': case 'o':
+                spec += "ll";
+                spec += conversion;
+                out.appendFormatted(spec.c_str(), static_cast<unsigned long long>(asUInt(arg)));
+                return;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                spec += conversion;
+                out.appendFormatted(spec.c_str(), asDouble(arg));
+                return;
+            case 's':
+                if (arg.type == ArgType::String) {
+                    // the payload isn't nul terminated, the stored length becomes the precision.
+                    spec.erase(std::min(spec.find('.'), spec.size()));
+                    spec += ".*s";
+                    out.appendFormatted(spec.c_str(), static_cast<int>(arg.s.length), arg.s.data);
+                } else {
+                    out.appendFormatted("%lld", static_cast<long long>(asInt(arg)));
+                }
+                return;
+            case 'p':
+                out.appendFormatted("%p", reinterpret_cast<void*>(static_cast<uintptr_t>(arg.u)));
+                return;
+            default:
+                out.append(spec.data(), spec.size());
+                out.append(&conversion, 1);
+                return;
+        }
+    }
+
+    void format(Record const& record, LineBuilder& out) {
+        if (record.format == nullptr) {
+            out.append(reinterpret_cast<const char*>(record.payload), record.payloadBytes);
+            return;
+        }
+
+        ArgReader reader(record);
+        std::string spec;
+        const char* at = record.format;
+        while (*at != '\0') {
+            const char* percent = std::strchr(at, '%');
+            if (percent == nullptr) {
+                out.append(at, std::strlen(at));
+                return;
+            }
+            out.append(at, static_cast<std::size_t>(percent - at));
+            at = percent + 1;
+            if (*at == '%') {
+                out.append("%", 1);
+                ++at;
+                continue;
+            }
+
+            // flags, width and precision are kept, length modifiers are replaced by the stored type.
+            spec.assign("%");
+            while (*at != '\0' && std::strchr("-+ #0123456789.", *at) != nullptr)
+                spec += *at++;
+            while (*at != '\0' && std::strchr("hljztL", *at) != nullptr)
+                ++at;
+            if (*at == '\0') {
+                out.append(spec.data(), spec.size());
+                return;
+            }
+            char const conversion = *at++;
+
+            Arg arg{};
+            if (!reader.next(arg)) {
+                // more conversions than arguments (or the payload was cut short).
+                out.append(spec.data(), spec.size());
+                out.append(&conversion, 1);
+                continue;
+            }
+            formatArg(out, spec, conversion, arg);
+        }
+    }
+
+    void emit(Record const& record, const char* text) {
+#ifdef __ANDROID__
+        static constexpr int priorities[] = {
+                ANDROID_LOG_VERBOSE, ANDROID_LOG_DEBUG, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR
+        };
+        __android_log_write(priorities[static_cast<int>(record.level)], record.tag, text);
+#else
+        static constexpr char letters[] = {'V', 'D', 'I', 'W', 'E'};
+        std::fprintf(stderr, "%10.3f %c %s [%u] %s\n", static_cast<double>(record.timestampNs) * 1e-9,
+                     letters[static_cast<int>(record.level)], record.tag, record.threadId, text);
+#endif
+    }
+
+    // writes out everything published so far, returns how many records that was.
+    std::size_t drain(LineBuilder& line) {
+        Ring& records = ring();
+        std::size_t count = 0;
+        while (Record* record = records.peek()) {
+            line.clear();
+            format(*record, line);
+            emit(*record, line.c_str());
+            records.release(record);
+            ++count;
+        }
+        return count;
+    }
+
+    void run() {
+        LineBuilder line;
+        uint32_t reportedDrops = 0;
+        for (;;) {
+            bool const stopping = !writer.running.load(std::memory_order_acquire);
+            std::size_t const count = drain(line);
+            writer.written.fetch_add(count, std::memory_order_release);
+
+            uint32_t const drops = ring().dropped.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                Record notice{};
+                notice.tag = "DoodleLog";
+                notice.level = Level::Warn;
+                notice.threadId = currentThreadId();
+                notice.timestampNs = Clock::monotonicNs();
+                char text[64];
+                std::snprintf(text, sizeof(text), "%u log records dropped, the ring was full", drops - reportedDrops);
+                emit(notice, text);
+                reportedDrops = drops;
+            }
+
+            if (stopping)
+                return;
+            if (count == 0)
+                std::this_thread::sleep_for(idleWait);
+        }
+    }
+}
+
+void start() {
+    if (writer.running.exchange(true))
+        return;
+    ring();
+    writer.thread = std::thread(run);
+}
+
+void stop() {
+    if (!writer.running.exchange(false))
+        return;
+    writer.thread.join();
+}
+
+void flush() {
+    // records are written in order, so once the writer got past the last one claimed so far,
+    // everything logged before this call is out.
+    std::size_t const target = ring().claimed();
+    while (writer.running.load(std::memory_order_acquire)
+           && writer.written.load(std::memory_order_acquire) < target)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+uint32_t droppedRecords() {
+    return ring().dropped.load(std::memory_order_relaxed);
+}
+
+void writeText(Level level, const char* tag, const char* text, std::size_t length) {
+    Record* record = detail::claim(level, tag, nullptr);
+    if (record == nullptr)
+        return;
+    // leave the last byte alone so the payload can always be read as text.
+    length = std::min(length, sizeof(record->payload) - 1);
+    std::memcpy(record->payload, text, length);
+    record->payloadBytes = static_cast<uint16_t>(length);
+    detail::commit(record);
+}
+
+namespace detail {
+    Record* claim(Level level, const char* tag, const char* format) {
+        Record* record = ring().claim();
+        if (record == nullptr)
+            return nullptr;
+        record->timestampNs = Clock::monotonicNs();
+        record->tag = tag;
+        record->format = format;
+        record->threadId = currentThreadId();
+        record->level = level;
+        record->payloadBytes = 0;
+        return record;
+    }
+
+    void commit(Record* record) {
+        // the slot's current sequence is the position it was claimed at.
+        Ring::publish(record, record->sequence.load(std::memory_order_relaxed));
+    }
+
+    void ArgWriter::putString(const char* text, std::size_t length) {
+        std::size_t const room = sizeof(record.payload) - record.payloadBytes;
+        if (full || room < 1 + sizeof(uint16_t)) {
+            full = true;
+            return;
+        }
+        // strings are cut to fit, and end the payload when they had to be.
+        std::size_t const stored = std::min(length, room - 1 - sizeof(uint16_t));
+        auto const storedLength = static_cast<uint16_t>(stored);
+        uint8_t* out = record.payload + record.payloadBytes;
+        out[0] = static_cast<uint8_t>(ArgType::String);
+        std::memcpy(out + 1, &storedLength, sizeof(uint16_t));
+        std::memcpy(out + 1 + sizeof(uint16_t), text, stored);
+        record.payloadBytes += static_cast<uint16_t>(1 + sizeof(uint16_t) + stored);
+        full = stored < length;
+    }
+}
+}
@@ -0,0 +1,174 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_LOG_H
+#define DOODLE_LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/*!
+ * Asynchronous logging.
+ *
+ * A log call never formats and never blocks: it claims a preallocated record in a lock-free
+ * multi-producer ring, copies the format pointer and the raw argument values into it, and returns.
+ * A background thread (Log::start) formats the records printf style and writes them to logcat,
+ * or to stderr on the host. When the ring is full the record is dropped and counted instead.
+ *
+ * Use the DOODLE_LOG* macros, they compile to nothing below DOODLE_LOG_LEVEL:
+ *
+ *     DOODLE_LOGI("DoodleEngine", "texture %d loaded from %s", id, path);
+ *
+ * The format must be a string literal (only its pointer is stored). Arguments can be integers,
+ * enums, floating point, C strings, std::string and pointers. '*' widths are not supported.
+ */
+
+// 0 verbose, 1 debug, 2 info, 3 warn, 4 error, 5 nothing
+#ifndef DOODLE_LOG_LEVEL
+#   ifdef NDEBUG
+#       define DOODLE_LOG_LEVEL 2
+#   else
+#       define DOODLE_LOG_LEVEL 0
+#   endif
+#endif
+
+namespace Log {
+    enum class Level : uint8_t {
+        Verbose,
+        Debug,
+        Info,
+        Warn,
+        Error
+    };
+
+    // starts and stops the thread that writes records out. stop() writes whatever is left first.
+    // records logged before start() wait in the ring.
+    void start();
+    void stop();
+    // waits until everything logged so far has been written, only while started.
+    void flush();
+    // records lost because the ring was full.
+    uint32_t droppedRecords();
+
+    // already formatted text, truncated to what fits in a record.
+    void writeText(Level level, const char* tag, const char* text, std::size_t length);
+
+    namespace detail {
+        constexpr std::size_t recordBytes   = 256;
+        constexpr std::size_t recordCount   = 512;
+
+        enum class ArgType : uint8_t { Int, UInt, Double, String, Pointer };
+
+        struct RecordHeader {
+            std::atomic<std::size_t> sequence;
+            int64_t timestampNs;
+            const char* tag;
+            const char* format;         // null when the payload is plain text
+            uint32_t threadId;
+            Level level;
+            uint16_t payloadBytes;
+        };
+
+        struct Record : RecordHeader {
+            uint8_t payload[recordBytes - sizeof(RecordHeader)];
+        };
+
+        static_assert(sizeof(Record) == recordBytes, "records are meant to be a fixed size");
+
+        // claims a free record, or returns null if the ring is full. must be followed by commit().
+        Record* claim(Level level, const char* tag, const char* format);
+        void commit(Record* record);
+
+        // appends arguments to a record's payload, an argument that doesn't fit ends the payload.
+        class ArgWriter {
+        public:
+            explicit ArgWriter(Record& record) : record { record } {}
+
+            template <typename T>
+            void add(T const& value) {
+                using U = std::decay_t<T>;
+                if constexpr (std::is_same_v<U, bool>) {
+                    put(ArgType::Int, static_cast<int64_t>(value));
+                } else if constexpr (std::is_enum_v<U>) {
+                    put(ArgType::Int, static_cast<int64_t>(value));
+                } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+                    put(ArgType::Int, static_cast<int64_t>(value));
+                } else if constexpr (std::is_integral_v<U>) {
+                    put(ArgType::UInt, static_cast<uint64_t>(value));
+                } else if constexpr (std::is_floating_point_v<U>) {
+                    put(ArgType::Double, static_cast<double>(value));
+                } else if constexpr (std::is_same_v<U, std::string>) {
+                    putString(value.data(), value.size());
+                } else if constexpr (std::is_convertible_v<T const&, const char*>) {
+                    const char* text = value;
+                    putString(text, text != nullptr ? std::strlen(text) : 0);
+                } else if constexpr (std::is_pointer_v<U>) {
+                    put(ArgType::Pointer, reinterpret_cast<uint64_t>(value));
+                } else {
+                    static_assert(std::is_void_v<T>, "unsupported log argument type");
+                }
+            }
+
+        private:
+            template <typename V>
+            void put(ArgType type, V value) {
+                if (full || record.payloadBytes + 1 + sizeof(V) > sizeof(record.payload)) {
+                    full = true;
+                    return;
+                }
+                uint8_t* out = record.payload + record.payloadBytes;
+                out[0] = static_cast<uint8_t>(type);
+                std::memcpy(out + 1, &value, sizeof(V));
+                record.payloadBytes += static_cast<uint16_t>(1 + sizeof(V));
+            }
+
+            void putString(const char* text, std::size_t length);
+
+            Record& record;
+            bool full = false;
+        };
+    }
+
+    template <typename... Args>
+    void write(Level level, const char* tag, const char* format, Args const&... args) {
+        detail::Record* record = detail::claim(level, tag, format);
+        if (record == nullptr)
+            return;
+        detail::ArgWriter writer(*record);
+        (writer.add(args), ...);
+        detail::commit(record);
+    }
+}
+
+#if DOODLE_LOG_LEVEL <= 0
+#   define DOODLE_LOGV(tag, ...) ::Log::write(::Log::Level::Verbose, tag, __VA_ARGS__)
+#else
+#   define DOODLE_LOGV(tag, ...) ((void)0)
+#endif
+#if DOODLE_LOG_LEVEL <= 1
+#   define DOODLE_LOGD(tag, ...) ::Log::write(::Log::Level::Debug, tag, __VA_ARGS__)
+#else
+#   define DOODLE_LOGD(tag, ...) ((void)0)
+#endif
+#if DOODLE_LOG_LEVEL <= 2
+#   define DOODLE_LOGI(tag, ...) ::Log::write(::Log::Level::Info, tag, __VA_ARGS__)
+#else
+#   define DOODLE_LOGI(tag, ...) ((void)0)
+#endif
+#if DOODLE_LOG_LEVEL <= 3
+#   define DOODLE_LOGW(tag, ...) ::Log::write(::Log::Level::Warn, tag, __VA_ARGS__)
+#else
+#   define DOODLE_LOGW(tag, ...) ((void)0)
+#endif
+#if DOODLE_LOG_LEVEL <= 4
+#   define DOODLE_LOGE(tag, ...) ::Log::write(::Log::Level::Error, tag, __VA_ARGS__)
+#else
+#   define DOODLE_LOGE(tag, ...) ((void)0)
+#endif
+
+#endif //DOODLE_LOG_H
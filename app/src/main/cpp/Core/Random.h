@@ -0,0 +1,110 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_RANDOM_H
+#define DOODLE_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * PCG32 (O'Neill, XSH-RR variant): 64 bit state, 32 bit output, period 2^64 per stream.
+ *
+ * Every game (or tool worker) owns its own generator, so a run is fully determined by its seed and
+ * any number of them can run side by side. The stream selects one of 2^63 independent sequences
+ * for the same seed, so sub-systems that must not disturb each other's rolls (the level and the
+ * gameplay, see Game/LevelGenerator.h) draw from their own stream of the run seed.
+ *
+ * Bounded values use Lemire's multiply-shift with rejection, so there's no modulo bias.
+ */
+class Random {
+public:
+    static constexpr uint64_t defaultSeed   = 0x853c49e6748fea9bULL;
+    static constexpr uint64_t defaultStream = 0xda3e39cb94b95bdbULL;
+
+    explicit Random(uint64_t seed = defaultSeed, uint64_t stream = defaultStream) {
+        reseed(seed, stream);
+    }
+
+    void reseed(uint64_t seed, uint64_t stream = defaultStream) {
+        state = 0;
+        increment = (stream << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    // uniform over all 32 bit values.
+    uint32_t next() {
+        uint64_t const old = state;
+        state = old * multiplier + increment;
+        auto const xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto const rotation = static_cast<uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // uniform in [0, bound), bound must not be 0.
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(next()) * bound;
+        auto low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            // only the values in the uneven last slice are rejected, (2^32 - bound) % bound of them.
+            uint32_t const threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32u);
+    }
+
+    // uniform in [min, max], both inclusive.
+    int32_t nextInRange(int32_t min, int32_t max) {
+        uint32_t const span = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1u;
+        // span wraps to 0 only for the full 32 bit range.
+        uint32_t const offset = span == 0 ? next() : nextBelow(span);
+        return static_cast<int32_t>(static_cast<uint32_t>(min) + offset);
+    }
+
+    // uniform in [0, 1), 24 bits so every value is exactly representable.
+    float nextFloat() {
+        return static_cast<float>(next() >> 8u) * 0x1.0p-24f;
+    }
+
+    // uniform in [min, max).
+    float nextFloat(float min, float max) {
+        return min + (max - min) * nextFloat();
+    }
+
+    // true with probability numerator / denominator.
+    bool chance(uint32_t numerator, uint32_t denominator) {
+        return nextBelow(denominator) < numerator;
+    }
+
+    // ---- batches ----
+    // same values, in the same order, as calling the single value version count times.
+
+    void fill(uint32_t* out, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = next();
+    }
+
+    void fillBelow(uint32_t* out, std::size_t count, uint32_t bound) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = nextBelow(bound);
+    }
+
+    void fillFloats(float* out, std::size_t count, float min, float max) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = nextFloat(min, max);
+    }
+
+private:
+    static constexpr uint64_t multiplier = 6364136223846793005ULL;
+
+    uint64_t state;
+    uint64_t increment;
+};
+
+#endif //DOODLE_RANDOM_H
@@ -0,0 +1,50 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_RINGBUFFER_H
+#define DOODLE_RINGBUFFER_H
+
+#include <array>
+#include <cstddef>
+
+/*!
+ * Fixed size history ring for a single thread. Pushing into a full ring overwrites the oldest
+ * element, so it always holds the most recent Capacity values. Index 0 is the oldest element.
+ *
+ * Unlike SPSCQueue this is not thread safe, it's meant for data produced and consumed on the same
+ * thread (sensor samples read on the game thread's looper, for instance).
+ */
+template <typename T, std::size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    void push(T const& value) {
+        slots_[(start_ + count_) & mask] = value;
+        if (count_ == Capacity)
+            start_ = (start_ + 1) & mask;
+        else
+            ++count_;
+    }
+
+    T const& operator[](std::size_t index) const { return slots_[(start_ + index) & mask]; }
+    T const& front() const { return (*this)[0]; }
+    T const& back() const { return (*this)[count_ - 1]; }
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == Capacity; }
+    void clear() { start_ = 0; count_ = 0; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    std::array<T, Capacity> slots_{};
+    std::size_t start_ = 0;
+    std::size_t count_ = 0;
+};
+
+#endif //DOODLE_RINGBUFFER_H
@@ -0,0 +1,70 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_SPSCQUEUE_H
+#define DOODLE_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*!
+ * Bounded, lock-free, single producer / single consumer ring.
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may call pop(). Storage is
+ * inline, so the queue never allocates after construction. Capacity must be a power of two.
+ */
+template <typename T, std::size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // returns false when the ring is full, the value is not consumed in that case.
+    bool push(T const& value) {
+        std::size_t const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity)
+            return false;
+        slots_[tail & mask] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns false when the ring is empty.
+    bool pop(T& value) {
+        std::size_t const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+        value = slots_[head & mask];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // the oldest value without taking it, nullptr when the ring is empty. consumer only, valid until
+    // its next pop().
+    T const* front() const {
+        std::size_t const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots_[head & mask];
+    }
+
+    // approximate when called from a third thread, exact from either endpoint.
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    // head and tail live on separate cache lines so producer and consumer don't false share.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::array<T, Capacity> slots_{};
+};
+
+#endif //DOODLE_SPSCQUEUE_H
@@ -0,0 +1,65 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "StartupTrace.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "Log.h"
+
+#define LOG_TAG "DoodleStartup"
+
+void StartupTrace::start() {
+    startNs = Clock::monotonicNs();
+}
+
+void StartupTrace::record(char const* stage, int64_t beginNs, char const* detail) {
+    if (finished.load(std::memory_order_relaxed))
+        return;
+    uint32_t const index = claimed.fetch_add(1, std::memory_order_relaxed);
+    if (index >= maxStages)
+        return;
+    Stage& slot = stages[index];
+    slot.name = stage;
+    slot.detail = detail;
+    slot.beginNs = beginNs;
+    slot.endNs = Clock::monotonicNs();
+    slot.thread = static_cast<int32_t>(gettid());
+    slot.written.store(true, std::memory_order_release);
+}
+
+void StartupTrace::finish() {
+    if (finished.exchange(true, std::memory_order_acq_rel))
+        return;
+    int64_t const firstFrameNs = Clock::monotonicNs();
+    std::size_t const count = std::min<std::size_t>(claimed.load(std::memory_order_relaxed), maxStages);
+
+    // start order, a stage still being written on another thread is left out.
+    std::array<Stage const*, maxStages> order{};
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (stages[i].written.load(std::memory_order_acquire))
+            order[written++] = &stages[i];
+    }
+    std::sort(order.begin(), order.begin() + written,
+              [](Stage const* a, Stage const* b) { return a->beginNs < b->beginNs; });
+
+    int32_t const mainThread = static_cast<int32_t>(gettid());
+    DOODLE_LOGI(LOG_TAG, "time to first frame %.2f ms, %zu stages (start, duration)", (firstFrameNs - startNs) / 1e6, written);
+    for (std::size_t i = 0; i < written; ++i) {
+        Stage const& stage = *order[i];
+        DOODLE_LOGI(LOG_TAG, "  %8.2f ms %8.2f ms  %s  %s %s",
+                    (stage.beginNs - startNs) / 1e6, (stage.endNs - stage.beginNs) / 1e6,
+                    stage.thread == mainThread ? "main" : "job ",
+                    stage.name, stage.detail ? stage.detail : "");
+    }
+    if (claimed.load(std::memory_order_relaxed) > maxStages)
+        DOODLE_LOGW(LOG_TAG, "%u stages dropped", claimed.load(std::memory_order_relaxed) - static_cast<uint32_t>(maxStages));
+}
+
+StartupTrace& startupTrace() {
+    static StartupTrace trace;
+    return trace;
+}
@@ -0,0 +1,72 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_STARTUPTRACE_H
+#define DOODLE_STARTUPTRACE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Clock.h"
+
+/*!
+ * The timeline of a cold start, from android_main to the first frame on screen.
+ *
+ * Each init stage is recorded with its start, end and thread, from whichever thread runs it, so
+ * the decodes on the jobs show up next to what the game thread does meanwhile. finish() logs the
+ * stages in start order and the time to first frame, records after that are dropped.
+ *
+ * Stage names and details must outlive the trace, string literals or asset paths that stay put.
+ */
+class StartupTrace {
+public:
+    static constexpr std::size_t maxStages = 64;
+
+    // the start of the timeline, everything is measured from here.
+    void start();
+    // a stage from `beginNs` (Clock::monotonicNs) to now. any thread, dropped when full.
+    void record(char const* stage, int64_t beginNs, char const* detail = nullptr);
+    // logs the timeline, the first frame was just presented.
+    void finish();
+    bool isFinished() const { return finished.load(std::memory_order_acquire); }
+
+    // records its scope as a stage.
+    class Scope {
+    public:
+        explicit Scope(StartupTrace& trace, char const* stage, char const* detail = nullptr) :
+                trace { trace }, stage { stage }, detail { detail }, beginNs { Clock::monotonicNs() } {}
+        ~Scope() { trace.record(stage, beginNs, detail); }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        StartupTrace& trace;
+        char const*   stage;
+        char const*   detail;
+        int64_t       beginNs;
+    };
+
+private:
+    struct Stage {
+        char const*       name;
+        char const*       detail;
+        int64_t           beginNs;
+        int64_t           endNs;
+        int32_t           thread;
+        std::atomic<bool> written{false};    // set once the fields above are
+    };
+
+    int64_t startNs = 0;
+    std::atomic<bool> finished{false};
+    std::atomic<uint32_t> claimed{0};
+    std::array<Stage, maxStages> stages;
+};
+
+// the process wide trace, a start only happens once per process.
+StartupTrace& startupTrace();
+
+#endif //DOODLE_STARTUPTRACE_H
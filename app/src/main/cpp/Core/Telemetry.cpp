@@ -0,0 +1,49 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "Telemetry.h"
+
+void Telemetry::publish(TelemetrySnapshot const& snapshot) {
+    // the offsets are what the UI reads, keep them in sync with the member order.
+    static_assert(offsetof(Telemetry, sequence)    == sequenceOffset, "telemetry layout changed");
+    static_assert(offsetof(Telemetry, score)       == scoreOffset, "telemetry layout changed");
+    static_assert(offsetof(Telemetry, height)      == heightOffset, "telemetry layout changed");
+    static_assert(offsetof(Telemetry, fps)         == fpsOffset, "telemetry layout changed");
+    static_assert(offsetof(Telemetry, frameTimeMs) == frameTimeOffset, "telemetry layout changed");
+    static_assert(offsetof(Telemetry, frameCount)  == frameCountOffset, "telemetry layout changed");
+
+    uint32_t const start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    score.store(snapshot.score, std::memory_order_relaxed);
+    height.store(snapshot.height, std::memory_order_relaxed);
+    fps.store(snapshot.fps, std::memory_order_relaxed);
+    frameTimeMs.store(snapshot.frameTimeMs, std::memory_order_relaxed);
+    frameCount.store(snapshot.frameCount, std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+TelemetrySnapshot Telemetry::read() const {
+    TelemetrySnapshot snapshot;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        snapshot.score       = score.load(std::memory_order_relaxed);
+        snapshot.height      = height.load(std::memory_order_relaxed);
+        snapshot.fps         = fps.load(std::memory_order_relaxed);
+        snapshot.frameTimeMs = frameTimeMs.load(std::memory_order_relaxed);
+        snapshot.frameCount  = frameCount.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+    return snapshot;
+}
+
+Telemetry& telemetry() {
+    static Telemetry block;
+    return block;
+}
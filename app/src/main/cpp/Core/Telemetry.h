@@ -0,0 +1,67 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_TELEMETRY_H
+#define DOODLE_TELEMETRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// a consistent copy of the live values.
+struct TelemetrySnapshot {
+    int32_t score;
+    float height;
+    float fps;
+    float frameTimeMs;
+    uint32_t frameCount;
+};
+
+/*!
+ * Live per-frame values shared with the UI without any JNI call.
+ *
+ * The block lives in native memory for the whole process and is handed to Kotlin once as a direct
+ * ByteBuffer, so its layout is part of the contract with MainActivity (see the offsets below).
+ * Writes are published with a seqlock: the sequence is odd while the game thread is writing, and a
+ * reader retries until it sees the same even sequence before and after copying the fields.
+ * Kotlin only has the acquire fences that needs from API 33 on, older releases go through read()
+ * with one JNI call per frame instead.
+ *
+ * publish() is game thread only, read() may be called from any thread.
+ */
+class alignas(64) Telemetry {
+public:
+    // byte offsets inside the shared block, native endian.
+    static constexpr std::size_t sequenceOffset    = 0;
+    static constexpr std::size_t scoreOffset       = 4;
+    static constexpr std::size_t heightOffset      = 8;
+    static constexpr std::size_t fpsOffset         = 12;
+    static constexpr std::size_t frameTimeOffset   = 16;
+    static constexpr std::size_t frameCountOffset  = 20;
+
+    void publish(TelemetrySnapshot const& snapshot);
+    TelemetrySnapshot read() const;
+
+    void* data() { return this; }
+    static constexpr std::size_t size() { return 64; }
+
+private:
+    std::atomic<uint32_t> sequence{0};
+    // the fields are atomics only so the racy reads the seqlock tolerates are well defined,
+    // every access to them is relaxed.
+    std::atomic<int32_t>  score{0};
+    std::atomic<float>    height{0.f};
+    std::atomic<float>    fps{0.f};
+    std::atomic<float>    frameTimeMs{0.f};
+    std::atomic<uint32_t> frameCount{0};
+};
+
+static_assert(sizeof(Telemetry) == Telemetry::size(), "telemetry must fill exactly one cache line");
+static_assert(std::atomic<float>::is_always_lock_free && sizeof(std::atomic<float>) == sizeof(float),
+              "the shared layout needs plain, lock-free atomics");
+
+// the process wide block, it outlives the engine so the buffer handed to the UI stays valid.
+Telemetry& telemetry();
+
+#endif //DOODLE_TELEMETRY_H
@@ -0,0 +1,72 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "UiEventChannel.h"
+
+void UiEventChannel::publishScore(int32_t score) {
+    // redundant updates never leave the game thread.
+    if (score == lastScore)
+        return;
+    lastScore = score;
+    pendingScore.store(packScore(++sequence, score), std::memory_order_release);
+}
+
+void UiEventChannel::publishGameOver(int32_t finalScore) {
+    flushScore();
+    lastScore = finalScore;
+    push(UiEvent{UiEventType::GameOver, finalScore});
+}
+
+void UiEventChannel::publishState(int32_t state) {
+    flushScore();
+    push(UiEvent{UiEventType::StateChanged, state});
+}
+
+std::size_t UiEventChannel::drain(UiEvent* out, std::size_t maxEvents) {
+    if (maxEvents == 0)
+        return 0;
+    // the slot first: everything queued before it was stored is visible now, anything queued after
+    // is newer and has a higher sequence.
+    uint64_t score = pendingScore.exchange(noScore, std::memory_order_acq_rel);
+    std::size_t count = 0;
+    while (count < maxEvents) {
+        Queued const* next = events.front();
+        // wrap safe, sequences only ever grow by one at a time.
+        bool const scoreFirst = score != noScore
+                && (!next || static_cast<int32_t>(next->sequence - sequenceOf(score)) > 0);
+        if (scoreFirst) {
+            out[count++] = scoreEvent(score);
+            score = noScore;
+            continue;
+        }
+        if (!next)
+            break;
+        out[count++] = next->event;
+        Queued popped;
+        events.pop(popped);
+    }
+    // out of room with older events still queued. the score goes back behind them, unless the game
+    // has a newer one by now, which replaces it like any other.
+    if (score != noScore) {
+        uint64_t expected = noScore;
+        pendingScore.compare_exchange_strong(expected, score, std::memory_order_acq_rel);
+    }
+    return count;
+}
+
+void UiEventChannel::push(UiEvent event) {
+    if (!events.push(Queued{event, ++sequence}))
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+void UiEventChannel::flushScore() {
+    uint64_t const score = pendingScore.exchange(noScore, std::memory_order_acq_rel);
+    if (score != noScore)
+        push(scoreEvent(score));
+}
+
+UiEventChannel& uiEvents() {
+    static UiEventChannel channel;
+    return channel;
+}
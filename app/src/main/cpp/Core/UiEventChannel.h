@@ -0,0 +1,90 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_UIEVENTCHANNEL_H
+#define DOODLE_UIEVENTCHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "SPSCQueue.h"
+
+// values are part of the contract with MainActivity, don't renumber.
+enum class UiEventType : int32_t {
+    ScoreChanged = 1,
+    GameOver     = 2,
+    StateChanged = 3
+};
+
+// two ints, so a batch can be copied into a java int[] as (type, value) pairs.
+struct UiEvent {
+    UiEventType type;
+    int32_t value;
+};
+
+static_assert(sizeof(UiEvent) == 2 * sizeof(int32_t), "ui events are copied as int pairs");
+
+/*!
+ * One way channel from the game thread to the UI.
+ *
+ * Discrete events (game over, state changes) go through an SPSC ring. Score updates are coalesced
+ * instead: the game thread only keeps the latest value in a single slot, so no matter how many
+ * frames the game runs between two drains, the UI sees at most one score per drain, and none when
+ * the value did not change. Before a discrete event is queued the pending score is flushed into the
+ * ring, so the UI always sees events in the order the game produced them.
+ *
+ * Events and the score slot carry a game thread sequence number. drain() takes the slot first and
+ * hands it out just before the first queued event that is newer, so a score that raced in behind
+ * a game over (the drain ran between the two) still comes out after it.
+ *
+ * publish* must only be called from the game thread and drain() only from the UI thread.
+ */
+class UiEventChannel {
+public:
+    static constexpr std::size_t capacity = 32;
+
+    // ---- game thread ----
+    void publishScore(int32_t score);
+    void publishGameOver(int32_t finalScore);
+    void publishState(int32_t state);
+
+    // ---- ui thread ----
+    // copies up to maxEvents pending events into out, oldest first, and returns how many were written.
+    std::size_t drain(UiEvent* out, std::size_t maxEvents);
+
+    // discrete events lost because the UI was not draining (e.g. while paused).
+    uint32_t dropped() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    // sequence in the high half, score in the low half. sequences start at 1, so 0 is never a score.
+    static constexpr uint64_t noScore = 0;
+
+    struct Queued {
+        UiEvent  event;
+        uint32_t sequence;
+    };
+
+    void push(UiEvent event);
+    void flushScore();
+
+    static uint64_t packScore(uint32_t sequence, int32_t score) {
+        return (static_cast<uint64_t>(sequence) << 32u) | static_cast<uint32_t>(score);
+    }
+    static uint32_t sequenceOf(uint64_t packed) { return static_cast<uint32_t>(packed >> 32u); }
+    static UiEvent scoreEvent(uint64_t packed) {
+        return UiEvent{UiEventType::ScoreChanged, static_cast<int32_t>(static_cast<uint32_t>(packed))};
+    }
+
+    SPSCQueue<Queued, capacity> events;
+    std::atomic<uint64_t> pendingScore{noScore};    // latest score the UI has not picked up yet
+    std::atomic<uint32_t> droppedEvents{0};
+    int64_t lastScore = INT64_MIN;                  // game thread only
+    uint32_t sequence = 0;                          // game thread only, of the last event or score
+};
+
+// the process wide channel, it outlives the engine so the UI can drain across window changes.
+UiEventChannel& uiEvents();
+
+#endif //DOODLE_UIEVENTCHANNEL_H
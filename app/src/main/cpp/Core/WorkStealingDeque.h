@@ -0,0 +1,90 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_WORKSTEALINGDEQUE_H
+#define DOODLE_WORKSTEALINGDEQUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * Bounded Chase-Lev work stealing deque of pointers.
+ *
+ * The owning thread push()es and pop()s at the bottom, like a stack, so it keeps working on what it
+ * queued last while it's still in cache. Any other thread may steal() from the top, the oldest
+ * entry. Only the last entry is ever contended, owner and thieves settle it with one CAS on top.
+ *
+ * The memory orders follow Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (2013), without the growing buffer: storage is inline and push() fails when it's full. push()
+ * publishes with a release store of bottom instead of a release fence, which is all a thief needs
+ * and something ThreadSanitizer understands. Capacity must be a power of two.
+ */
+template <typename T, std::size_t Capacity>
+class WorkStealingDeque {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // owner only. false when the deque is full, nothing was queued then.
+    bool push(T* value) {
+        int64_t const bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t const top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(Capacity))
+            return false;
+        slots_[static_cast<std::size_t>(bottom) & mask].store(value, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // owner only. the newest entry, nullptr when empty.
+    T* pop() {
+        int64_t const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* value = slots_[static_cast<std::size_t>(bottom) & mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // the last one, a thief may be taking it at the same time.
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                value = nullptr;
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    // any thread. the oldest entry, nullptr when empty or another thread won it.
+    T* steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+        T* value = slots_[static_cast<std::size_t>(top) & mask].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return value;
+    }
+
+    // approximate from any thread but the owner.
+    bool empty() const {
+        return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    // thieves hammer top, the owner bottom, so they get their own cache lines.
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::array<std::atomic<T*>, Capacity> slots_{};
+};
+
+#endif //DOODLE_WORKSTEALINGDEQUE_H
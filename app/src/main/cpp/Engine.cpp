@@ -6,61 +6,162 @@
 #include <android/imagedecoder.h>
 
 #include "AndroidUtils/AndroidOut.h"
+#include "Core/Telemetry.h"
+#include "Core/Clock.h"
+#include "Core/StartupTrace.h"
+#include "Core/UiEventChannel.h"
 
 Engine::Engine(android_app *pApp) :
         app_        (pApp),
+        jobs        (),
         renderer    (*this, pApp),
-        game        (*this, renderer.camera),
-        audioManager (pApp)
+        game        (*this, renderer.camera, uiEvents()),
+        frameOldestTouchNs (0),
+        frameOldestTiltNs (0),
+        updateStartNs (0),
+        presentLeadNs (initialPresentLeadNs),
+        predictedTilt (0.f),
+        audioManager (pApp),
+        statsTimer (0.f),
+        audioStats {},
+        frameTimeMs (0.f),
+        frameCount (0)
 {
-    // Initialize the Sensor Manager and poll source
+    // Sensor events wake the looper through this poll source, the sensor itself is only turned
+    // on while playing (see update).
     sensorPollSource.id = LOOPER_ID_USER;
     sensorPollSource.app = pApp;
     sensorPollSource.process = Callback_OnSensorEvent;
-    sensorManager = ASensorManager_getInstance();
-    if(!sensorManager){
-        aout<< "Unable to get Sensor Manager";
-        return;
-    }
-    sensorEventQueue = ASensorManager_createEventQueue(sensorManager, pApp->looper,
-            LOOPER_ID_USER, NULL, &sensorPollSource);
-    // Intialize the Accelerometer
-    accelerometer = ASensorManager_getDefaultSensor(sensorManager, ASENSOR_TYPE_ACCELEROMETER);
-    if(!accelerometer){
-        aout<< "Unable to get Accelerometer";
-        return;
-    }
-    if(ASensorEventQueue_enableSensor(sensorEventQueue,accelerometer) < 0){
-        aout << "Unable to enable Accelerometer";
-        return;
-    }
-    int32_t minDelay = ASensor_getMinDelay(accelerometer);
-    if(ASensorEventQueue_setEventRate(sensorEventQueue,accelerometer,minDelay) < 0){
-        aout << "Unable to set Accelerometer Rate";
-        return;
-    }
+    accelerometer.init(pApp->looper, LOOPER_ID_USER, &sensorPollSource);
 
-    if(audioManager.start() == STATUS_KO){
-        aout << "Failed to start audioManager";
+    // the texture preload is decoding on the jobs meanwhile, see Renderer::preloadTextures.
+    {
+        StartupTrace::Scope stage{startupTrace(), "audio engine"};
+        if(audioManager.start() == STATUS_KO){
+            aout << "Failed to start audioManager";
+        }
     }
+    {
+        StartupTrace::Scope stage{startupTrace(), "audio preload"};
+        game.preloadAudio();
+    }
+    LOGI("job system with %u threads", jobs.getThreadCount());
 }
 
 Engine::~Engine() {
-    // Free the Accelerometer
-    if(accelerometer){
-        ASensorEventQueue_disableSensor(sensorEventQueue, accelerometer);
-        accelerometer = nullptr;
-    }
+    // the accelerometer releases the sensor and its event queue itself.
+}
+
+void Engine::attachWindow() {
+    int64_t const startNs = Clock::monotonicNs();
+    bool const rebuilt = renderer.attachWindow();
+    startupTrace().record("window", startNs);
+    audioManager.setPaused(false);
+    // the present lead is measured from the next update, not from before the background.
+    updateStartNs = 0;
+    LOGI("window attached in %.2f ms, %s", (Clock::monotonicNs() - startNs) / 1e6,
+         rebuilt ? "GL resources built" : "context kept");
+}
+
+void Engine::detachWindow() {
+    renderer.detachWindow();
+    audioManager.setPaused(true);
+    // the sensor comes back on with the first update that needs it.
+    if (accelerometer.setMode(SensorMode::Off))
+        tilt.reset();
 }
 
 
 void Engine::render() {
     renderer.render();
+
+    // the swap just returned, which is as close to the present as we can see without frame
+    // timestamps. every input this frame reflected is measured against it.
+    int64_t const presentNs = Clock::monotonicNs();
+    // the first one ends the startup.
+    if (!startupTrace().isFinished()) {
+        startupTrace().record("first frame", updateStartNs);
+        startupTrace().finish();
+    }
+    // how far ahead of the update the picture shows up, smoothed, tilt is predicted that far ahead.
+    if (updateStartNs != 0)
+        presentLeadNs += (presentNs - updateStartNs - presentLeadNs) / 8;
+    if (frameOldestTouchNs != 0)
+        touchLatency.record(presentNs - frameOldestTouchNs);
+    if (frameOldestTiltNs != 0)
+        tiltLatency.record(presentNs - frameOldestTiltNs);
+    frameOldestTouchNs = 0;
+    frameOldestTiltNs = 0;
+}
+
+void Engine::consumeInput() {
+    inputQueue.consume([this](InputEvent const& event) {
+        // events come oldest first, so the first of each kind is what this frame gets tagged with.
+        switch (event.type) {
+            case InputEventType::Tilt: {
+                if (frameOldestTiltNs == 0)
+                    frameOldestTiltNs = event.timestampNs;
+                SensorSample const sample{event.timestampNs, glm::vec3{event.x, event.y, event.z}};
+                tilt.consume(&sample, 1);
+                break;
+            }
+            case InputEventType::Touch:
+                // nothing is driven by touch yet, it's only measured.
+                if (frameOldestTouchNs == 0)
+                    frameOldestTouchNs = event.timestampNs;
+                break;
+        }
+    });
 }
 
 void Engine::update(float deltaTime) {
+    updateStartNs = Clock::monotonicNs();
+    if (menuMusicRequested.exchange(false, std::memory_order_acquire))
+        playAudio("menuBGM.mp3", true);
+    consumeInput();
+    bool const autopiloted = autopilotEnabled();
+    if (autopiloted) {
+        // soak runs: the bot plays, and starts the next run as soon as one ends.
+        if (game.getState() == DoodleGame::GameState::Awake || game.getState() == DoodleGame::GameState::GameOver)
+            game.StartGame();
+        predictedTilt = autopilot.steer(game, deltaTime);
+    } else {
+        // the player moves with the tilt expected when this frame is on screen, not the last sample.
+        predictedTilt = tiltPredictor.predict(tilt, updateStartNs + presentLeadNs);
+    }
     game.update(deltaTime);
     game.updateUI(deltaTime);
+    // nothing reads tilt outside of gameplay, so don't keep the sensor (and the looper) busy.
+    bool const sensorNeeded = !autopiloted && game.getState() == DoodleGame::GameState::Playing;
+    if (accelerometer.setMode(sensorNeeded ? SensorMode::Gameplay : SensorMode::Off))
+        tilt.reset();
+    publishTelemetry(deltaTime);
+
+    statsTimer += deltaTime;
+    if(statsTimer >= statsInterval){
+        statsTimer = 0.f;
+        audioStats = audioManager.sampleStats();
+        aout << audioStats << std::endl;
+        aout << "input to present, tilt " << tiltLatency.summarize()
+             << " | touch " << touchLatency.summarize() << std::endl;
+        tiltLatency.reset();
+        touchLatency.reset();
+    }
+}
+
+void Engine::publishTelemetry(float deltaTime) {
+    // smoothed so the overlay doesn't flicker, still settles within a few frames.
+    float const deltaMs = deltaTime * 1000.f;
+    frameTimeMs = frameCount == 0 ? deltaMs : frameTimeMs + (deltaMs - frameTimeMs) * frameTimeSmoothing;
+    ++frameCount;
+
+    telemetry().publish(TelemetrySnapshot{
+            static_cast<int32_t>(game.getScore()),
+            game.getHeight(),
+            frameTimeMs > 0.f ? 1000.f / frameTimeMs : 0.f,
+            frameTimeMs,
+            frameCount
+    });
 }
 
 GLuint Engine::getTextureId(std::string const& filepath) {
@@ -76,6 +177,7 @@ void Engine::handleInput() {
     }
 
     // handle motion events (motionEventsCounts can be 0).
+    // they are only queued here, the simulation consumes them in timestamp order with the sensors.
     for (auto i = 0; i < inputBuffer->motionEventsCount; i++) {
         auto &motionEvent = inputBuffer->motionEvents[i];
         auto action = motionEvent.action;
@@ -83,49 +185,42 @@ void Engine::handleInput() {
         // Find the pointer index, mask and bitshift to turn it into a readable value.
         auto pointerIndex = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK)
                 >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
-        aout << "Pointer(s): ";
 
-        // get the x and y position of this event if it is not ACTION_MOVE.
-        auto &pointer = motionEvent.pointers[pointerIndex];
-        auto x = GameActivityPointerAxes_getX(&pointer);
-        auto y = GameActivityPointerAxes_getY(&pointer);
+        auto pushPointer = [&](GameActivityPointerAxes const& pointer, TouchAction touchAction) {
+            inputQueue.push(InputEvent{
+                    motionEvent.eventTime,
+                    InputEventType::Touch,
+                    touchAction,
+                    static_cast<uint8_t>(pointer.id),
+                    GameActivityPointerAxes_getX(&pointer),
+                    GameActivityPointerAxes_getY(&pointer),
+                    0.f
+            });
+        };
 
         // determine the action type and process the event accordingly.
         switch (action & AMOTION_EVENT_ACTION_MASK) {
             case AMOTION_EVENT_ACTION_DOWN:
             case AMOTION_EVENT_ACTION_POINTER_DOWN:
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Down";
+                pushPointer(motionEvent.pointers[pointerIndex], TouchAction::Down);
                 break;
 
             case AMOTION_EVENT_ACTION_CANCEL:
-                // treat the CANCEL as an UP event: doing nothing in the app, except
-                // removing the pointer from the cache if pointers are locally saved.
+                // treat the CANCEL as an UP event.
                 // code pass through on purpose.
             case AMOTION_EVENT_ACTION_UP:
             case AMOTION_EVENT_ACTION_POINTER_UP:
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Up";
+                pushPointer(motionEvent.pointers[pointerIndex], TouchAction::Up);
                 break;
             case AMOTION_EVENT_ACTION_MOVE:
                 // There is no pointer index for ACTION_MOVE, only a snapshot of
-                // all active pointers; app needs to cache previous active pointers
-                // to figure out which ones are actually moved.
-                for (auto index = 0; index < motionEvent.pointerCount; index++) {
-                    pointer = motionEvent.pointers[index];
-                    x = GameActivityPointerAxes_getX(&pointer);
-                    y = GameActivityPointerAxes_getY(&pointer);
-                    aout << "(" << pointer.id << ", " << x << ", " << y << ")";
-
-                    if (index != (motionEvent.pointerCount - 1)) aout << ",";
-                    aout << " ";
-                }
-                aout << "Pointer Move";
+                // all active pointers.
+                for (auto index = 0; index < motionEvent.pointerCount; index++)
+                    pushPointer(motionEvent.pointers[index], TouchAction::Move);
                 break;
             default:
-                aout << "Unknown MotionEvent Action: " << action;
+                LOGD("Unknown MotionEvent Action: %d", action);
         }
-        aout << std::endl;
     }
     // clear the motion input count in this buffer for main thread to re-use.
     android_app_clear_motion_events(inputBuffer);
@@ -133,22 +228,20 @@ void Engine::handleInput() {
     // handle input key events.
     for (auto i = 0; i < inputBuffer->keyEventsCount; i++) {
         auto &keyEvent = inputBuffer->keyEvents[i];
-        aout << "Key: " << keyEvent.keyCode <<" ";
         switch (keyEvent.action) {
             case AKEY_EVENT_ACTION_DOWN:
-                aout << "Key Down";
+                LOGD("Key: %d Key Down", keyEvent.keyCode);
                 break;
             case AKEY_EVENT_ACTION_UP:
-                aout << "Key Up";
+                LOGD("Key: %d Key Up", keyEvent.keyCode);
                 break;
             case AKEY_EVENT_ACTION_MULTIPLE:
                 // Deprecated since Android API level 29.
-                aout << "Multiple Key Actions";
+                LOGD("Key: %d Multiple Key Actions", keyEvent.keyCode);
                 break;
             default:
-                aout << "Unknown KeyEvent Action: " << keyEvent.action;
+                LOGD("Key: %d Unknown KeyEvent Action: %d", keyEvent.keyCode, keyEvent.action);
         }
-        aout << std::endl;
     }
     // clear the key input count too.
     android_app_clear_key_events(inputBuffer);
@@ -160,18 +253,29 @@ void Engine::Callback_OnSensorEvent(android_app *pApp, android_poll_source *pSou
 }
 
 void Engine::OnSensorEvent() {
-    ASensorEvent event;
-    while(ASensorEventQueue_getEvents(sensorEventQueue,&event,1) > 0)
-        if(event.type == ASENSOR_TYPE_ACCELEROMETER)
-            acceleration = glm::vec3{event.acceleration.x,event.acceleration.y, event.acceleration.z};
+    accelerometer.drain(inputQueue);
 }
 
-glm::vec3 Engine::GetAccelerometerAcceleration() const { return acceleration; }
+glm::vec3 Engine::GetAccelerometerAcceleration() const { return predictedTilt; }
+
+SoundId Engine::preloadSound(const char* path) {
+    return audioManager.preload(path);
+}
 
-AudioManager Engine::getAudioManager() {
+AudioManager& Engine::getAudioManager() {
     return audioManager;
 }
 
+AudioStats const& Engine::getAudioStats() const {
+    return audioStats;
+}
+
+void Engine::playMusic(SoundId sound, bool loopBool) {
+    audioManager.stop(musicVoice);
+    musicVoice = audioManager.play(sound, loopBool);
+}
+
 void Engine::playAudio(const char *path, bool loopBool) {
-    audioManager.playBGM(path, loopBool);
+    // preload only does the work once per path
+    playMusic(audioManager.preload(path), loopBool);
 }
@@ -1,23 +1,34 @@
 #ifndef ANDROIDGLINVESTIGATIONS_RENDERER_H
 #define ANDROIDGLINVESTIGATIONS_RENDERER_H
 
+#include <atomic>
 #include <memory>
-#include <android/sensor.h>
 #include <game-activity/native_app_glue/android_native_app_glue.h>
-#include <android/log.h>
 #include "Game/DoodleGame.h"
+#include "Game/GameHost.h"
+#include "Game/Autopilot.h"
 #include "Graphics/Renderer.h"
 #include "AudioManager.h"
+#include "Core/Log.h"
+#include "Input/AccelerometerSensor.h"
+#include "Input/AccelerometerPipeline.h"
+#include "Input/TiltPredictor.h"
+#include "Input/InputQueue.h"
+#include "Core/LatencyHistogram.h"
+#include "Core/JobSystem.h"
 
 #define LOG_TAG "DoodleEngine" // This is the 'Tag' you will search for in Logcat
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO,  LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+// asynchronous, see Core/Log.h. debug and info are compiled out of release builds.
+#define LOGD(...) DOODLE_LOGD(LOG_TAG, __VA_ARGS__)
+#define LOGI(...) DOODLE_LOGI(LOG_TAG, __VA_ARGS__)
+#define LOGW(...) DOODLE_LOGW(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) DOODLE_LOGE(LOG_TAG, __VA_ARGS__)
 
 using GLuint = unsigned int;
 
 struct android_app;
 
-class Engine {
+class Engine : public GameHost {
 public:
     /*!
      * @param pApp the android_app this Engine belongs to, needed to configure GL
@@ -25,6 +36,21 @@ public:
     Engine(android_app *pApp);
 
     ~Engine();
+
+    /*!
+     * The app has a window (again). The game, audio and input carry on where they were, only the
+     * surface is new, and the GL resources too when the context didn't survive.
+     */
+    void attachWindow();
+
+    /*!
+     * The window is going, the app is heading to the background. Everything but the surface is
+     * kept, audio is paused and the sensor turned off until attachWindow().
+     */
+    void detachWindow();
+
+    // nothing to update or render without one.
+    bool hasWindow() const { return renderer.hasWindow(); }
     /*!
      * Handles input from the android_app.
      *
@@ -33,7 +59,8 @@ public:
     void handleInput();
 
     /*!
-     * Renders all the models in the renderer
+     * Renders all the models in the renderer, and measures how long the input this frame reflects
+     * took to reach the screen.
      */
     void render();
 
@@ -42,28 +69,68 @@ public:
      */
     void update(float deltaTime);
 
-    GLuint getTextureId(std::string const& filepath);
+    GLuint getTextureId(std::string const& filepath) override;
+    SoundId preloadSound(const char* path) override;
 
-    // Data from Gyroscope
-    glm::vec3 GetAccelerometerAcceleration() const;
+    // Filtered accelerometer reading, predicted for when the current frame is presented, or the
+    // autopilot's tilt while it's enabled (see Game/Autopilot.h). Zero outside of gameplay
+    glm::vec3 GetAccelerometerAcceleration() const override;
+    JobSystem& getJobs() override { return jobs; }
 private:
     static void Callback_OnSensorEvent(android_app* pApp,android_poll_source* pSource);
     void OnSensorEvent();
+    // feeds everything queued since the last frame to the simulation, oldest first.
+    void consumeInput();
+    // pushes this frame's values into the telemetry block read by the UI.
+    void publishTelemetry(float deltaTime);
 
 public:
     android_app *app_;              // reference to the original android app.
+    JobSystem jobs;                 // workers for the game and the renderer, this (game) thread is the owner.
     Renderer renderer;              // responsible for graphics
     DoodleGame game;                // holds all the game objects and are in charge of their logic.
-    AudioManager getAudioManager();
+    AudioManager& getAudioManager();
+    // switches the background music, the previous track is stopped.
+    void playMusic(SoundId sound, bool loopBool = true) override;
     void playAudio(const char* path, bool loopBool);
+    // any thread, the menu music starts with the next update. audio is game thread only, so the UI
+    // posts this instead of calling playAudio.
+    void requestMenuMusic() { menuMusicRequested.store(true, std::memory_order_release); }
+    // audio health over the last logging window.
+    AudioStats const& getAudioStats() const;
 private:
-    // Sensor Variables
-    ASensorManager* sensorManager;
-    ASensorEventQueue* sensorEventQueue;
+    // Input, queued as it arrives and consumed by the simulation once per frame
+    InputQueue inputQueue;
     android_poll_source sensorPollSource;
-    const ASensor* accelerometer;
-    glm::vec3 acceleration;
+    AccelerometerSensor accelerometer;
+    AccelerometerPipeline tilt;
+
+    // Oldest input (engine clock) reflected by the frame being built, 0 when there was none
+    int64_t frameOldestTouchNs;
+    int64_t frameOldestTiltNs;
+    LatencyHistogram touchLatency;
+    LatencyHistogram tiltLatency;
+
+    // Tilt prediction, targets the present time of the frame being updated
+    static constexpr int64_t initialPresentLeadNs = 16'000'000;
+    TiltPredictor tiltPredictor;
+    int64_t updateStartNs;
+    int64_t presentLeadNs;
+    glm::vec3 predictedTilt;
+    Autopilot autopilot;
     AudioManager audioManager;
+    VoiceHandle musicVoice;
+    std::atomic<bool> menuMusicRequested{false};
+
+    // Audio stats and input latency are sampled and logged on this period (seconds)
+    static constexpr float statsInterval = 5.f;
+    float statsTimer;
+    AudioStats audioStats;
+
+    // Frame timing shared with the UI through the telemetry block
+    static constexpr float frameTimeSmoothing = 0.1f;
+    float frameTimeMs;
+    uint32_t frameCount;
 };
 
 #endif //ANDROIDGLINVESTIGATIONS_RENDERER_H
\ No newline at end of file
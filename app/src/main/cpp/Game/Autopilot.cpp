@@ -0,0 +1,124 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "Autopilot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "DoodleGame.h"
+#include "Collision/Broadphase.h"
+#include "../Graphics/Camera.h"
+
+namespace {
+#ifdef DOODLE_AUTOPILOT
+    std::atomic<bool> enabled{true};
+#else
+    std::atomic<bool> enabled{false};
+#endif
+
+    // only this much of the overlap with a platform counts as a landing, the rest is the margin
+    // for the steering lagging behind the plan.
+    constexpr float landingMargin = 0.8f;
+}
+
+Autopilot::Autopilot(Params const& params) :
+        params { params }
+{}
+
+glm::vec3 Autopilot::steer(DoodleGame& game, float deltaTime) {
+    target = Entity{};
+    if (game.getState() != DoodleGame::GameState::Playing || deltaTime <= 0.f)
+        return glm::vec3{0.f};
+
+    World& world = game.getWorld();
+    Transform const& player = *world.get<Transform>(game.getPlayer());
+    PlayerMotion const& motion = *world.get<PlayerMotion>(game.getPlayer());
+    float const gravity = game.getGravity();
+    // the player wraps around between -halfRange and halfRange, so sideways distances are taken
+    // the short way around that circle.
+    float const halfRange = game.getCamera().scale.x / 2.f - player.scale.x / 2.f;
+    float const span = 2.f * halfRange;
+
+    // the highest platform in reach, or failing that the one we miss by the least.
+    Entity best;
+    float bestY = -std::numeric_limits<float>::infinity();
+    float bestShortfall = std::numeric_limits<float>::infinity();
+    float bestDx = 0.f;
+    float bestTime = 0.f;
+    // crumbled platforms lose their Collider, nothing lands on them any more.
+    world.forEach<Transform const, PlatformInfo const, Collider const>(
+            [&](Entity entity, Transform const& platform, PlatformInfo const& info, Collider const& collider) {
+        // bounced on this frame, the Collider only goes at the end of it.
+        if (collider.proxy == invalidProxy)
+            return;
+        float const landY = platform.position.y + platform.scale.y / 2.f + player.scale.y / 2.f;
+        float const time = timeToLand(player, motion, gravity, landY);
+        if (time < 0.f)
+            return;
+
+        // moving platforms are led by their current speed, a turn at the end of the travel is
+        // caught by the next steps' plans.
+        float const landX = platform.position.x + info.displacement.x / deltaTime * time;
+        float dx = std::clamp(landX, -halfRange, halfRange) - player.position.x;
+        if (dx > halfRange)
+            dx -= span;
+        else if (dx < -halfRange)
+            dx += span;
+        float const slack = (platform.scale.x + player.scale.x) / 2.f * landingMargin;
+        float const needed = std::max(0.f, std::fabs(dx) - slack);
+        float const shortfall = std::max(0.f, needed - reach(dx >= 0.f ? motion.velocity.x : -motion.velocity.x, time));
+
+        bool const better = shortfall < bestShortfall
+                || (shortfall == bestShortfall && shortfall == 0.f
+                    && (landY > bestY || (landY == bestY && std::fabs(dx) < std::fabs(bestDx))));
+        if (!better)
+            return;
+        best = entity;
+        bestY = landY;
+        bestShortfall = shortfall;
+        bestDx = dx;
+        bestTime = time;
+    });
+    if (!best.valid())
+        return glm::vec3{0.f};
+    target = best;
+
+    // spread the move over the rest of the fall, arriving over the middle of the platform.
+    float const wanted = std::clamp(bestDx / std::max(bestTime, deltaTime),
+                                    -PlayerTuning::maxMovementSpeed, PlayerTuning::maxMovementSpeed);
+    float const acceleration = (wanted - motion.velocity.x) / std::max(params.responseTime, deltaTime);
+    // the game accelerates the player against the x axis of the tilt.
+    float const tilt = std::clamp(-acceleration / PlayerTuning::movementAcceleration, -params.maxTilt, params.maxTilt);
+    return glm::vec3{tilt, 0.f, 0.f};
+}
+
+float Autopilot::timeToLand(Transform const& player, PlayerMotion const& motion, float gravity, float landY) {
+    // y(t) = y + vy t - g t^2 / 2 reaches landY on the way down at the larger root.
+    float const vy = motion.velocity.y;
+    float const discriminant = vy * vy - 2.f * gravity * (landY - player.position.y);
+    if (discriminant < 0.f)
+        return -1.f;
+    float const time = (vy + std::sqrt(discriminant)) / gravity;
+    return time >= 0.f ? time : -1.f;
+}
+
+float Autopilot::reach(float speed, float time) const {
+    // full tilt toward the target until the speed caps out.
+    float const acceleration = params.maxTilt * PlayerTuning::movementAcceleration;
+    float const maxSpeed = PlayerTuning::maxMovementSpeed;
+    speed = std::clamp(speed, -maxSpeed, maxSpeed);
+    float const rampTime = std::min(time, (maxSpeed - speed) / acceleration);
+    return speed * rampTime + 0.5f * acceleration * rampTime * rampTime + maxSpeed * (time - rampTime);
+}
+
+void setAutopilotEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool autopilotEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
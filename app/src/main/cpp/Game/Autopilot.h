@@ -0,0 +1,56 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AUTOPILOT_H
+#define DOODLE_AUTOPILOT_H
+
+#include <glm/vec3.hpp>
+
+#include "Components.h"
+#include "Ecs/World.h"
+
+class DoodleGame;
+
+/*!
+ * A bot that plays DoodleGame through the tilt input, for soak tests and benchmark runs.
+ *
+ * Every frame it looks at the platforms that are spawned, works out which ones the player can
+ * still land on (the fall has to reach the platform's top, and the player has to cover the
+ * horizontal distance, wrap around included, with the tilt it's allowed before then) and steers
+ * toward the highest of them. The result is a tilt reading, so the game runs exactly the code it
+ * runs for a human.
+ *
+ * It only reads the game, so a deterministic game (fixed seed and step) stays deterministic.
+ */
+class Autopilot {
+public:
+    struct Params {
+        float maxTilt      = 9.81f;   // m/s^2, what a phone held at 90 degrees reads
+        float responseTime = 0.05f;   // seconds to reach the wanted speed, shorter is twitchier
+    };
+
+    Autopilot() = default;
+    explicit Autopilot(Params const& params);
+
+    // the tilt to feed the game for a step of deltaTime, zero outside of gameplay.
+    glm::vec3 steer(DoodleGame& game, float deltaTime);
+
+    // the platform steered toward in the last step, invalid when there was none.
+    Entity getTarget() const { return target; }
+
+private:
+    // seconds until the player falls onto a top at `landY`, < 0 when its jump can't reach it.
+    static float timeToLand(Transform const& player, PlayerMotion const& motion, float gravity, float landY);
+    // furthest the player can move sideways in `time`, starting at `speed` toward the target.
+    float reach(float speed, float time) const;
+
+    Params params{};
+    Entity target;
+};
+
+// launch time selection, read by the engine every frame. starts on in DOODLE_AUTOPILOT builds.
+void setAutopilotEnabled(bool enable);
+bool autopilotEnabled();
+
+#endif //DOODLE_AUTOPILOT_H
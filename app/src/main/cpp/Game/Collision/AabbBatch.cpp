@@ -0,0 +1,150 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AabbBatch.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define DOODLE_AABB_NEON 1
+#elif defined(__AVX__)
+#   include <immintrin.h>
+#   define DOODLE_AABB_AVX 1
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#   define DOODLE_AABB_SSE 1
+#endif
+
+namespace {
+    inline uint64_t overlapBit(AABB const& query, AabbSoA const& boxes, std::size_t i) {
+        // & rather than &&, so there's nothing to mispredict.
+        return static_cast<uint64_t>((boxes.minX[i] <= query.max.x) & (query.min.x <= boxes.maxX[i])
+                                   & (boxes.minY[i] <= query.max.y) & (query.min.y <= boxes.maxY[i]));
+    }
+
+    // scalar loop over [begin, count), for the tail the vector loops leave behind.
+    std::size_t maskTail(AABB const& query, AabbSoA const& boxes, std::size_t begin, uint64_t* mask) {
+        std::size_t hits = 0;
+        for (std::size_t i = begin; i < boxes.count; ++i) {
+            uint64_t const bit = overlapBit(query, boxes, i);
+            mask[i / 64] |= bit << (i % 64);
+            hits += bit;
+        }
+        return hits;
+    }
+
+    std::size_t firstTail(AABB const& query, AabbSoA const& boxes, std::size_t begin) {
+        for (std::size_t i = begin; i < boxes.count; ++i) {
+            if (overlapBit(query, boxes, i))
+                return i;
+        }
+        return boxes.count;
+    }
+
+#if DOODLE_AABB_NEON
+    constexpr std::size_t lanes = 4;
+
+    // one bit per lane, lane 0 in bit 0.
+    inline uint32_t laneBits(AABB const& query, AabbSoA const& boxes, std::size_t i) {
+        uint32x4_t const inside = vandq_u32(
+                vandq_u32(vcleq_f32(vld1q_f32(boxes.minX + i), vdupq_n_f32(query.max.x)),
+                          vcleq_f32(vdupq_n_f32(query.min.x), vld1q_f32(boxes.maxX + i))),
+                vandq_u32(vcleq_f32(vld1q_f32(boxes.minY + i), vdupq_n_f32(query.max.y)),
+                          vcleq_f32(vdupq_n_f32(query.min.y), vld1q_f32(boxes.maxY + i))));
+        static uint32_t const weights[lanes] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(inside, vld1q_u32(weights)));
+    }
+#elif DOODLE_AABB_AVX
+    constexpr std::size_t lanes = 8;
+
+    inline uint32_t laneBits(AABB const& query, AabbSoA const& boxes, std::size_t i) {
+        __m256 const inside = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(boxes.minX + i), _mm256_set1_ps(query.max.x), _CMP_LE_OQ),
+                              _mm256_cmp_ps(_mm256_set1_ps(query.min.x), _mm256_loadu_ps(boxes.maxX + i), _CMP_LE_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(boxes.minY + i), _mm256_set1_ps(query.max.y), _CMP_LE_OQ),
+                              _mm256_cmp_ps(_mm256_set1_ps(query.min.y), _mm256_loadu_ps(boxes.maxY + i), _CMP_LE_OQ)));
+        return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+    }
+#elif DOODLE_AABB_SSE
+    constexpr std::size_t lanes = 4;
+
+    inline uint32_t laneBits(AABB const& query, AabbSoA const& boxes, std::size_t i) {
+        __m128 const inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minX + i), _mm_set1_ps(query.max.x)),
+                           _mm_cmple_ps(_mm_set1_ps(query.min.x), _mm_loadu_ps(boxes.maxX + i))),
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minY + i), _mm_set1_ps(query.max.y)),
+                           _mm_cmple_ps(_mm_set1_ps(query.min.y), _mm_loadu_ps(boxes.maxY + i))));
+        return static_cast<uint32_t>(_mm_movemask_ps(inside));
+    }
+#endif
+}
+
+std::size_t AabbBatch::Scalar::overlapMask(AABB const& query, AabbSoA const& boxes, uint64_t* mask) {
+    std::size_t hits = 0;
+    // built up in a register a word at a time, rather than or-ed into memory per box.
+    for (std::size_t word = 0, i = 0; i < boxes.count; ++word) {
+        uint64_t bits = 0;
+        for (std::size_t bit = 0; bit < 64 && i < boxes.count; ++bit, ++i)
+            bits |= overlapBit(query, boxes, i) << bit;
+        mask[word] = bits;
+        hits += static_cast<std::size_t>(__builtin_popcountll(bits));
+    }
+    return hits;
+}
+
+std::size_t AabbBatch::Scalar::firstOverlap(AABB const& query, AabbSoA const& boxes) {
+    return firstTail(query, boxes, 0);
+}
+
+#if DOODLE_AABB_NEON || DOODLE_AABB_AVX || DOODLE_AABB_SSE
+
+std::size_t AabbBatch::overlapMask(AABB const& query, AabbSoA const& boxes, uint64_t* mask) {
+    // lanes divides 64, so a group never straddles two words.
+    std::size_t const vectorEnd = boxes.count - boxes.count % lanes;
+    std::size_t hits = 0;
+    std::size_t i = 0;
+    for (std::size_t word = 0; i < vectorEnd; ++word) {
+        uint64_t bits = 0;
+        for (std::size_t shift = 0; shift < 64 && i < vectorEnd; shift += lanes, i += lanes)
+            bits |= static_cast<uint64_t>(laneBits(query, boxes, i)) << shift;
+        mask[word] = bits;
+        hits += static_cast<std::size_t>(__builtin_popcountll(bits));
+    }
+    // the word holding the tail may have been written partially above, or not at all.
+    if (i < boxes.count && i % 64 == 0)
+        mask[i / 64] = 0;
+    return hits + maskTail(query, boxes, i, mask);
+}
+
+std::size_t AabbBatch::firstOverlap(AABB const& query, AabbSoA const& boxes) {
+    std::size_t const vectorEnd = boxes.count - boxes.count % lanes;
+    for (std::size_t i = 0; i < vectorEnd; i += lanes) {
+        if (uint32_t const bits = laneBits(query, boxes, i))
+            return i + static_cast<std::size_t>(__builtin_ctz(bits));
+    }
+    return firstTail(query, boxes, vectorEnd);
+}
+
+#else
+
+std::size_t AabbBatch::overlapMask(AABB const& query, AabbSoA const& boxes, uint64_t* mask) {
+    return Scalar::overlapMask(query, boxes, mask);
+}
+
+std::size_t AabbBatch::firstOverlap(AABB const& query, AabbSoA const& boxes) {
+    return Scalar::firstOverlap(query, boxes);
+}
+
+#endif
+
+const char* AabbBatch::kernelName() {
+#if DOODLE_AABB_NEON
+    return "neon";
+#elif DOODLE_AABB_AVX
+    return "avx";
+#elif DOODLE_AABB_SSE
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,49 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_AABBBATCH_H
+#define DOODLE_AABBBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Collision.h"
+
+// boxes as structure of arrays, `count` floats in each.
+struct AabbSoA {
+    float const* minX;
+    float const* minY;
+    float const* maxX;
+    float const* maxY;
+    std::size_t  count;
+};
+
+/*!
+ * One query box against many boxes, without a branch per box.
+ *
+ * Compiled for NEON on arm64, AVX (when the compiler targets it) or SSE2 on x86, and plain C++
+ * elsewhere. Every version follows overlaps(): touching edges count. The Scalar namespace has the
+ * branch free C++ version on every platform, for comparison.
+ */
+namespace AabbBatch {
+    // words needed for the hit mask of `count` boxes.
+    constexpr std::size_t maskWords(std::size_t count) { return (count + 63) / 64; }
+
+    // sets bit i % 64 of mask[i / 64] for every box i that overlaps the query, clears the rest.
+    // returns the number of hits.
+    std::size_t overlapMask(AABB const& query, AabbSoA const& boxes, uint64_t* mask);
+
+    // index of the first box that overlaps the query, boxes.count when none does.
+    std::size_t firstOverlap(AABB const& query, AabbSoA const& boxes);
+
+    // which implementation was compiled in, for logs and benchmarks.
+    const char* kernelName();
+}
+
+namespace AabbBatch::Scalar {
+    std::size_t overlapMask(AABB const& query, AabbSoA const& boxes, uint64_t* mask);
+    std::size_t firstOverlap(AABB const& query, AabbSoA const& boxes);
+}
+
+#endif //DOODLE_AABBBATCH_H
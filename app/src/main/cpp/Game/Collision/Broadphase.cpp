@@ -0,0 +1,209 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "Broadphase.h"
+
+#include <algorithm>
+
+#include "AabbBatch.h"
+#include "../../Core/JobSystem.h"
+
+namespace {
+    // more new proxies than this at once and insertion stops being the cheap way to sort them in.
+    constexpr std::size_t maxInsertedPerRepair = 64;
+
+    // proxies per range of a parallel sweep, below twice this the sweep stays on the calling thread.
+    constexpr std::size_t sweepGrain = 512;
+}
+
+Broadphase::Broadphase(std::size_t expectedProxies, std::size_t expectedPairs) {
+    minX.reserve(expectedProxies);
+    minY.reserve(expectedProxies);
+    maxX.reserve(expectedProxies);
+    maxY.reserve(expectedProxies);
+    types.reserve(expectedProxies);
+    users.reserve(expectedProxies);
+    alive.reserve(expectedProxies);
+    freeIds.reserve(expectedProxies);
+    order.reserve(expectedProxies);
+    pairs.reserve(expectedPairs);
+    queryMask.reserve(AabbBatch::maskWords(expectedProxies));
+}
+
+ProxyId Broadphase::add(AABB const& box, EntityType type, uint64_t user) {
+    ProxyId proxy;
+    if (!freeIds.empty()) {
+        proxy = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        proxy = static_cast<ProxyId>(minX.size());
+        minX.push_back(0.f);
+        minY.push_back(0.f);
+        maxX.push_back(0.f);
+        maxY.push_back(0.f);
+        types.push_back(type);
+        users.push_back(0);
+        alive.push_back(0);
+    }
+    types[proxy] = type;
+    users[proxy] = user;
+    alive[proxy] = 1;
+    update(proxy, box);
+    // new proxies go to the end and are sorted in by the next repair.
+    order.push_back(proxy);
+    ++live;
+    ++appended;
+    return proxy;
+}
+
+void Broadphase::update(ProxyId proxy, AABB const& box) {
+    minX[proxy] = box.min.x;
+    minY[proxy] = box.min.y;
+    maxX[proxy] = box.max.x;
+    maxY[proxy] = box.max.y;
+}
+
+void Broadphase::remove(ProxyId proxy) {
+    // the id is reused only after the next repair drops it from the order.
+    alive[proxy] = 0;
+    --live;
+    ++removed;
+}
+
+void Broadphase::clear() {
+    minX.clear();
+    minY.clear();
+    maxX.clear();
+    maxY.clear();
+    types.clear();
+    users.clear();
+    alive.clear();
+    freeIds.clear();
+    order.clear();
+    pairs.clear();
+    live = 0;
+    removed = 0;
+    appended = 0;
+}
+
+AABB Broadphase::boxOf(ProxyId proxy) const {
+    return AABB{glm::vec2{minX[proxy], minY[proxy]}, glm::vec2{maxX[proxy], maxY[proxy]}};
+}
+
+void Broadphase::repairOrder() {
+    if (removed != 0) {
+        std::size_t kept = 0;
+        for (ProxyId proxy : order) {
+            if (alive[proxy])
+                order[kept++] = proxy;
+            else
+                freeIds.push_back(proxy);
+        }
+        order.resize(kept);
+        removed = 0;
+    }
+
+    sortMoves = 0;
+    if (appended > maxInsertedPerRepair) {
+        appended = 0;
+        std::sort(order.begin(), order.end(), [this](ProxyId a, ProxyId b) { return minY[a] < minY[b]; });
+        return;
+    }
+    appended = 0;
+
+    // insertion sort, each proxy only moves as far as it moved past others since the last frame.
+    for (std::size_t i = 1; i < order.size(); ++i) {
+        ProxyId const proxy = order[i];
+        float const key = minY[proxy];
+        std::size_t j = i;
+        while (j > 0 && minY[order[j - 1]] > key) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = proxy;
+        sortMoves += i - j;
+    }
+}
+
+void Broadphase::findPairs() {
+    repairOrder();
+    pairs.clear();
+    sweep(0, order.size(), pairs);
+}
+
+void Broadphase::findPairs(JobSystem& jobs) {
+    repairOrder();
+    pairs.clear();
+    std::size_t const count = order.size();
+    std::size_t const ranges = std::min<std::size_t>(count / sweepGrain, jobs.getThreadCount() * 4);
+    if (ranges < 2) {
+        sweep(0, count, pairs);
+        return;
+    }
+    if (rangePairs.size() < ranges)
+        rangePairs.resize(ranges);
+    std::size_t const step = (count + ranges - 1) / ranges;
+    jobs.parallelFor(0, ranges, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t range = begin; range < end; ++range) {
+            rangePairs[range].clear();
+            sweep(std::min(count, range * step), std::min(count, (range + 1) * step), rangePairs[range]);
+        }
+    });
+    for (std::size_t range = 0; range < ranges; ++range)
+        pairs.insert(pairs.end(), rangePairs[range].begin(), rangePairs[range].end());
+}
+
+void Broadphase::sweep(std::size_t first, std::size_t last, std::vector<ProxyPair>& out) const {
+    std::size_t const count = order.size();
+    for (std::size_t i = first; i < last; ++i) {
+        ProxyId const a = order[i];
+        float const top = maxY[a];
+        float const left = minX[a];
+        float const right = maxX[a];
+        for (std::size_t j = i + 1; j < count; ++j) {
+            ProxyId const b = order[j];
+            // everything further up the order starts above this box.
+            if (minY[b] > top)
+                break;
+            if (minX[b] <= right && left <= maxX[b])
+                out.push_back(ProxyPair{a, b});
+        }
+    }
+}
+
+void Broadphase::query(AABB const& box, std::vector<ProxyId>& hits) {
+    hits.clear();
+    std::size_t const count = minX.size();
+    queryMask.resize(AabbBatch::maskWords(count));
+    AabbBatch::overlapMask(box, AabbSoA{minX.data(), minY.data(), maxX.data(), maxY.data(), count}, queryMask.data());
+    for (std::size_t word = 0; word < queryMask.size(); ++word) {
+        for (uint64_t bits = queryMask[word]; bits != 0; bits &= bits - 1) {
+            auto const proxy = static_cast<ProxyId>(word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits)));
+            // removed proxies keep their last box until the id is reused.
+            if (alive[proxy])
+                hits.push_back(proxy);
+        }
+    }
+}
+
+void NarrowphaseDispatcher::on(EntityType a, EntityType b, Handler handler, void* context) {
+    auto const first = static_cast<std::size_t>(a);
+    auto const second = static_cast<std::size_t>(b);
+    table[first][second] = Entry{handler, context, false};
+    if (first != second)
+        table[second][first] = Entry{handler, context, true};
+}
+
+void NarrowphaseDispatcher::dispatch(Broadphase const& broadphase) const {
+    for (ProxyPair const& pair : broadphase.getPairs()) {
+        Entry const& entry = table[static_cast<std::size_t>(broadphase.typeOf(pair.a))]
+                                  [static_cast<std::size_t>(broadphase.typeOf(pair.b))];
+        if (!entry.handler)
+            continue;
+        if (entry.swapped)
+            entry.handler(entry.context, broadphase, pair.b, pair.a);
+        else
+            entry.handler(entry.context, broadphase, pair.a, pair.b);
+    }
+}
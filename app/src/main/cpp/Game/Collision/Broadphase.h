@@ -0,0 +1,113 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_BROADPHASE_H
+#define DOODLE_BROADPHASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+#include "../Components.h"
+
+class JobSystem;
+
+using ProxyId = uint32_t;
+constexpr ProxyId invalidProxy = UINT32_MAX;
+
+// two proxies whose boxes overlap, `a` is the one lower in the sort.
+struct ProxyPair {
+    ProxyId a;
+    ProxyId b;
+};
+
+/*!
+ * Sweep and prune on the y axis.
+ *
+ * Proxies are kept sorted by the bottom of their box. The order is repaired with an insertion sort
+ * each findPairs(), which is close to linear when things only moved a little since the last frame
+ * (and the level only grows upwards). Large batches of new proxies get a full sort instead. The
+ * sweep then only compares boxes whose y ranges overlap and checks x on those.
+ *
+ * Boxes are stored structure of arrays, so the sweep streams through plain floats. With a JobSystem
+ * large sweeps are split into ranges of the order, each collecting its own pairs, which are then
+ * joined in range order, so the pair list is the same either way.
+ */
+class Broadphase {
+public:
+    // slots for this many proxies and pairs are allocated up front.
+    explicit Broadphase(std::size_t expectedProxies = 0, std::size_t expectedPairs = 0);
+
+    // `user` is the caller's, handed back by userOf(). the game stores the proxy's Entity there.
+    ProxyId add(AABB const& box, EntityType type, uint64_t user);
+    void    update(ProxyId proxy, AABB const& box);
+    void    remove(ProxyId proxy);
+    void    clear();
+
+    // rebuilds the pair list from the current boxes.
+    void findPairs();
+    // the same, sweeping on the jobs once there are enough proxies to be worth it.
+    void findPairs(JobSystem& jobs);
+    std::vector<ProxyPair> const& getPairs() const { return pairs; }
+
+    // every live proxy overlapping `box`, in id order. a linear pass with the AabbBatch kernel, for
+    // one off questions that don't need the pair list.
+    void query(AABB const& box, std::vector<ProxyId>& hits);
+
+    EntityType     typeOf(ProxyId proxy) const { return types[proxy]; }
+    uint64_t       userOf(ProxyId proxy) const { return users[proxy]; }
+    AABB           boxOf(ProxyId proxy) const;
+
+    std::size_t size() const { return live; }
+    // insertion sort moves in the last findPairs, a measure of how coherent the frame was.
+    std::size_t lastSortMoves() const { return sortMoves; }
+
+private:
+    void repairOrder();
+    // the pairs of order[first, last) with anything above them.
+    void sweep(std::size_t first, std::size_t last, std::vector<ProxyPair>& out) const;
+
+    // per proxy, indexed by ProxyId
+    std::vector<float>          minX, minY, maxX, maxY;
+    std::vector<EntityType>     types;
+    std::vector<uint64_t>       users;
+    std::vector<uint8_t>        alive;
+    std::vector<ProxyId>        freeIds;
+
+    std::vector<ProxyId>   order;   // live and removed proxies, sorted by minY
+    std::vector<ProxyPair> pairs;
+    std::vector<std::vector<ProxyPair>> rangePairs;     // one per range of a parallel sweep
+    std::vector<uint64_t>  queryMask;
+    std::size_t live{0};
+    std::size_t removed{0};         // dead entries still in `order`
+    std::size_t appended{0};        // proxies added since the last repair, not sorted in yet
+    std::size_t sortMoves{0};
+};
+
+/*!
+ * Routes broadphase pairs to narrowphase handlers by the types of the two objects.
+ *
+ * A handler registered for (A, B) always gets the A proxy first, whatever the order of the pair.
+ * Pairs without a handler are skipped.
+ */
+class NarrowphaseDispatcher {
+public:
+    using Handler = void (*)(void* context, Broadphase const& broadphase, ProxyId a, ProxyId b);
+
+    void on(EntityType a, EntityType b, Handler handler, void* context);
+    void dispatch(Broadphase const& broadphase) const;
+
+private:
+    static constexpr std::size_t typeCount = 3;   // one per EntityType
+
+    struct Entry {
+        Handler handler{nullptr};
+        void*   context{nullptr};
+        bool    swapped{false};
+    };
+    Entry table[typeCount][typeCount]{};
+};
+
+#endif //DOODLE_BROADPHASE_H
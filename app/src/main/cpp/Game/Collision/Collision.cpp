@@ -0,0 +1,47 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "Collision.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // entry and exit time of the move along one axis, false when the axis never overlaps.
+    bool axisInterval(float movingMin, float movingMax, float delta, float targetMin, float targetMax,
+                      float& entry, float& exit) {
+        if (delta == 0.f) {
+            if (movingMax < targetMin || movingMin > targetMax)
+                return false;
+            entry = -std::numeric_limits<float>::infinity();
+            exit = std::numeric_limits<float>::infinity();
+            return true;
+        }
+        float const toMin = (targetMin - movingMax) / delta;
+        float const toMax = (targetMax - movingMin) / delta;
+        entry = std::min(toMin, toMax);
+        exit = std::max(toMin, toMax);
+        return true;
+    }
+}
+
+bool sweep(AABB const& moving, glm::vec2 displacement, AABB const& target, SweepHit& hit) {
+    float entryX, exitX, entryY, exitY;
+    if (!axisInterval(moving.min.x, moving.max.x, displacement.x, target.min.x, target.max.x, entryX, exitX)
+     || !axisInterval(moving.min.y, moving.max.y, displacement.y, target.min.y, target.max.y, entryY, exitY))
+        return false;
+
+    float const entry = std::max(entryX, entryY);
+    float const exit = std::min(exitX, exitY);
+    if (entry > exit || entry < 0.f || entry > 1.f)
+        return false;
+
+    hit.time = entry;
+    // the axis that started overlapping last is the one that was hit.
+    if (entryX > entryY)
+        hit.normal = glm::vec2{displacement.x > 0.f ? -1.f : 1.f, 0.f};
+    else
+        hit.normal = glm::vec2{0.f, displacement.y > 0.f ? -1.f : 1.f};
+    return true;
+}
@@ -0,0 +1,38 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_COLLISION_H
+#define DOODLE_COLLISION_H
+
+#include <glm/vec2.hpp>
+
+struct AABB {
+    glm::vec2 min;
+    glm::vec2 max;
+
+    static AABB fromCenter(glm::vec2 center, glm::vec2 size) {
+        return AABB{center - size / 2.f, center + size / 2.f};
+    }
+};
+
+// touching edges count as overlapping.
+inline bool overlaps(AABB const& a, AABB const& b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x
+        && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+struct SweepHit {
+    float     time;     // fraction of the move at first contact, 0..1
+    glm::vec2 normal;   // face of `target` that was hit, pointing out of it
+};
+
+/*!
+ * Continuous test of `moving` travelling by `displacement` against a static `target` (slab method).
+ *
+ * Reports the first contact within the move. Boxes that already overlap at the start aren't a hit,
+ * the mover is treated as coming from inside, which is what one way platforms want.
+ */
+bool sweep(AABB const& moving, glm::vec2 displacement, AABB const& target, SweepHit& hit);
+
+#endif //DOODLE_COLLISION_H
@@ -0,0 +1,111 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_COMPONENTS_H
+#define DOODLE_COMPONENTS_H
+
+#include <cstdint>
+#include <limits>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "Ecs/World.h"
+
+using GLuint = unsigned int;
+constexpr inline static GLuint NO_TEXTURE = std::numeric_limits<GLuint>::max();
+
+// what an entity is to collision and in which layer it's drawn, environment first.
+enum class EntityType : uint8_t {
+    Player,
+    Platform,
+    Environment
+};
+
+// what a platform does, see PlatformBehaviours. values are stored in the level layout.
+enum class PlatformKind : uint8_t {
+    Static,
+    Moving,         // slides left and right
+    Oscillating,    // bobs up and down around where it spawned
+    Crumbling,      // holds for one bounce, then falls apart
+    Spring          // throws the player higher
+};
+
+// the player's handling, shared with the Autopilot and tools/levelcheck.
+struct PlayerTuning {
+    static constexpr float maxRotationTime      = 0.5f;
+    static constexpr int   rotationChance       = 60;     // out of 100
+    static constexpr float maxMovementSpeed     = 2000.f;
+    static constexpr float movementAcceleration = 750.f;
+    static constexpr float jumpVelocity         = 1750.f;
+};
+
+// ---- components ----
+// plain data, see Ecs/World.h. ids are the bit of the component in an archetype's mask, new ones
+// take the next free id.
+
+struct Transform {
+    static constexpr ComponentId componentId = 0;
+
+    glm::vec2 position{0.f};
+    glm::vec2 scale{1.f};
+    float     rotation{0.f};     // degrees
+};
+
+struct Sprite {
+    static constexpr ComponentId componentId = 1;
+
+    glm::vec4  colorMultiplier{1.f};
+    GLuint     textureId{NO_TEXTURE};
+    EntityType layer{EntityType::Environment};
+};
+
+// the entity's proxy in the game's Broadphase.
+struct Collider {
+    static constexpr ComponentId componentId = 2;
+
+    uint32_t proxy{UINT32_MAX};   // invalidProxy once it has left the broadphase
+};
+
+struct PlayerMotion {
+    static constexpr ComponentId componentId = 3;
+
+    glm::vec2 velocity{0.f};
+    glm::vec2 prevPos{0.f};
+    float     rotationTime{0.f};   // left of the current flip
+};
+
+struct PlatformInfo {
+    static constexpr ComponentId componentId = 4;
+
+    PlatformKind kind{PlatformKind::Static};
+    uint32_t     variant{0};            // which of the platform textures it has
+    glm::vec2    displacement{0.f};     // how far it moved this step, landings are swept relative to it
+};
+
+// back and forth between minX and maxX.
+struct MovingPath {
+    static constexpr ComponentId componentId = 5;
+
+    float minX;
+    float maxX;
+    float velocity;
+};
+
+// up and down around anchorY.
+struct Oscillation {
+    static constexpr ComponentId componentId = 6;
+
+    float anchorY;
+    float phase;        // radians
+};
+
+// a crumbling platform that was bounced on, falling and fading out.
+struct Crumble {
+    static constexpr ComponentId componentId = 7;
+
+    float velocity;
+    float timeLeft;
+};
+
+#endif //DOODLE_COMPONENTS_H
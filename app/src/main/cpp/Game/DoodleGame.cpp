@@ -3,98 +3,281 @@
 //
 
 #include "DoodleGame.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <glm/common.hpp>
+
 #include "../Graphics/Camera.h"
 
-#include "GameObject/Player.h"
-#include "GameObject/Platform.h"
-#include "GameObject/Background.h"
 #include "Utils.h"
-#include "../Engine.h"
-#include "../JNI_Bridge.h"
+#include "GameHost.h"
+#include "../Core/Log.h"
+#include "../Core/UiEventChannel.h"
+#include "../Core/Clock.h"
+#include "../Core/AllocationTracker.h"
+#include "Collision/Collision.h"
+
+#define LOG_TAG "DoodleGame"
+#define LOGI(...) DOODLE_LOGI(LOG_TAG, __VA_ARGS__)
+
+namespace {
+    const std::string platformPath[] = {
+         "Platform 1.png",
+         "Platform 2.png",
+         "Platform 3.png",
+         "Platform 4.png",
+         "Platform 5.png"
+    };
+
+    // the first generated platform sits this far above the player's start.
+    constexpr float firstPlatformOffset = 400.f;
+
+    // room for a screen and a few chunks of platforms on the tallest screens we expect.
+    constexpr std::size_t maxPlatforms = 128;
+    // a spawn queues the platform's components and a despawn its destroy.
+    constexpr std::size_t commandsPerPlatform = 6;
+    constexpr std::size_t bytesPerPlatform =
+            sizeof(Transform) + sizeof(Sprite) + sizeof(Collider) + sizeof(PlatformInfo) + sizeof(MovingPath);
+
+    // every effect of a run fits, with room for a few game over bursts in a row.
+    constexpr std::size_t particlePools = 8;
+    constexpr std::size_t particlesPerPool = 1024;
 
-DoodleGame::DoodleGame(Engine& engine, Camera& camera) :
-        engine { engine },
+    // there is one set of platform textures, kinds are told apart by their tint. by PlatformKind.
+    constexpr glm::vec4 kindTints[] = {
+            {1.f,  1.f,  1.f,  1.f},     // static
+            {0.6f, 0.8f, 1.f,  1.f},     // moving
+            {0.7f, 1.f,  0.7f, 1.f},     // oscillating
+            {0.8f, 0.6f, 0.45f, 1.f},    // crumbling
+            {1.f,  0.9f, 0.4f, 1.f}      // spring
+    };
+}
+
+DoodleGame::DoodleGame(GameHost& host, Camera& camera, UiEventChannel& events) :
+        broadphase{maxPlatforms + 1, maxPlatforms},
+        sweepFrom{0.f},
+        landingTime{1.f},
         camera { camera },
+        host { host },
+        events { events },
         gravity{2000},
-        nextPlatformSpawn{400}, // Start with some offset
         distanceBetweenPlatforms{150},
-        hasGameRunOnce{false},
         isGameOver{false},
-        gameState{GameState::Awake}
+        hasGameRunOnce{false},
+        level{host.getJobs()},
+        streamedTop{0},
+        fixedSeed{0},
+        runSeed{0},
+        gameState{GameState::Awake},
+        publishedState{GameState::Awake},
+        particles{particlePools, particlesPerPool},
+        score{0},
+        height{0}
 {
-    engine.getTextureId("Player.png");
-    engine.getTextureId("Scrolling Background.png");
-    engine.getTextureId("Platform 1.png");
+    narrowphase.on(EntityType::Player, EntityType::Platform, &DoodleGame::OnPlayerPlatform, this);
+    // every archetype a run goes through, at its fullest.
+    world.reserve<Transform, Sprite, Collider, PlayerMotion>(1);
+    world.reserve<Transform, Sprite>(1);
+    world.reserve<Transform, Sprite, Collider, PlatformInfo>(maxPlatforms);
+    world.reserve<Transform, Sprite, Collider, PlatformInfo, MovingPath>(maxPlatforms);
+    world.reserve<Transform, Sprite, Collider, PlatformInfo, Oscillation>(maxPlatforms);
+    world.reserve<Transform, Sprite, PlatformInfo, Crumble>(maxPlatforms);
+    world.reserve<Transform, Sprite, PlatformInfo>(maxPlatforms);
+    // despawns wait for the end of the frame and spawns don't, so both may hold an id at once.
+    world.reserveEntities(2 * maxPlatforms + 2);
+    commands.reserve(maxPlatforms * commandsPerPlatform, maxPlatforms * bytesPerPlatform);
+    host.getTextureId("Player.png");
+    host.getTextureId("Scrolling Background.png");
+    static_assert(std::size(platformPath) == platformVariants);
+    for (uint32_t i = 0; i < platformVariants; ++i)
+        platformTextures[i] = host.getTextureId(platformPath[i]);
+    AddEmitters();
+}
+
+void DoodleGame::AddEmitters() {
+    // colors are RGBA8 with red in the low byte.
+    ParticleEmitter bounce;
+    bounce.count = 10;
+    bounce.direction = -1.5707964f;
+    bounce.spread = 3.1415927f;
+    bounce.speedMin = 80.f;
+    bounce.speedMax = 260.f;
+    bounce.lifeMin = 0.25f;
+    bounce.lifeMax = 0.45f;
+    bounce.sizeMin = 10.f;
+    bounce.sizeMax = 18.f;
+    bounce.gravity = 300.f;
+    bounce.color = 0xC0F0F0F0;
+    bounceEmitter = particles.addEmitter(bounce);
 
+    ParticleEmitter spring;
+    spring.count = 24;
+    spring.spread = 1.2f;
+    spring.speedMin = 400.f;
+    spring.speedMax = 900.f;
+    spring.lifeMin = 0.4f;
+    spring.lifeMax = 0.7f;
+    spring.sizeMin = 8.f;
+    spring.sizeMax = 14.f;
+    spring.gravity = -1500.f;
+    spring.color = 0xFF64E6FF;
+    springEmitter = particles.addEmitter(spring);
+
+    // a crumbling platform breaks into chunks of its own texture.
+    ParticleEmitter debris;
+    debris.count = 12;
+    debris.direction = -1.5707964f;
+    debris.spread = 2.5f;
+    debris.speedMin = 100.f;
+    debris.speedMax = 400.f;
+    debris.lifeMin = 0.5f;
+    debris.lifeMax = 0.9f;
+    debris.sizeMin = 14.f;
+    debris.sizeMax = 28.f;
+    debris.gravity = -2500.f;
+    debris.color = 0xFF7399CC;
+    for (uint32_t i = 0; i < platformVariants; ++i) {
+        debris.texture = platformTextures[i];
+        debrisEmitters[i] = particles.addEmitter(debris);
+    }
+
+    ParticleEmitter gameOver;
+    gameOver.count = 48;
+    gameOver.spread = 1.4f;
+    gameOver.speedMin = 700.f;
+    gameOver.speedMax = 1600.f;
+    gameOver.lifeMin = 0.6f;
+    gameOver.lifeMax = 1.2f;
+    gameOver.sizeMin = 10.f;
+    gameOver.sizeMax = 22.f;
+    gameOver.gravity = -1800.f;
+    gameOver.color = 0xFF3030E0;
+    gameOverEmitter = particles.addEmitter(gameOver);
 }
 
-Player& DoodleGame::getPlayer() {
-    // the player must be valid.
-    return *dynamic_cast<Player*>(gameObjects[playerIndex].get());
+void DoodleGame::preloadAudio() {
+    bgmSound = host.preloadSound("BGM.mp3");
+    gameOverSound = host.preloadSound("GameOverBGM.mp3");
 }
 
 void DoodleGame::update(float deltaTime) {
     switch (gameState) {
         case GameState::Start:
             InitPlay();
+            commands.apply(world);
             break;
-        case GameState::Playing:
+        case GameState::Playing: {
+            // steady state gameplay stays off the heap, checked in DOODLE_TRACK_ALLOCATIONS builds.
+            NoAllocationScope noAllocations{"PlayTime"};
             PlayTime(deltaTime);
+            // the frame's spawns, despawns and crumbles, now that no system iterates the world.
+            commands.apply(world);
             break;
+        }
         default:
             break;
     }
+    // effects outlive the run, the game over burst plays while nothing else moves.
+    particles.update(deltaTime);
+
+    // StartGame/ResetGame come in from the UI thread, so state changes are reported from here,
+    // the only thread allowed to publish.
+    if (gameState != publishedState) {
+        publishedState = gameState;
+        events.publishState(static_cast<int32_t>(gameState));
+    }
 }
 
-std::vector<std::unique_ptr<GameObject>> const& DoodleGame::getGameObjects() {
-    return gameObjects;
+void DoodleGame::SpawnPlatform(PlatformDesc const& desc, float width) {
+    Entity const platform = commands.create(world);
+    uint32_t const variant = desc.variant % platformVariants;
+    Transform transform{glm::vec2{desc.x, desc.y}, glm::vec2{width > 0.f ? width : platformScale.x, platformScale.y}};
+    // may move it to where its cycle starts.
+    behaviours.add(commands, platform, desc.kind, transform, desc.phase, camera.scale.x / 2.f);
+    commands.add(platform, transform);
+    commands.add(platform, Sprite{kindTints[static_cast<std::size_t>(desc.kind)], platformTextures[variant], EntityType::Platform});
+    commands.add(platform, PlatformInfo{desc.kind, variant});
+    commands.add(platform, Collider{broadphase.add(
+            AABB::fromCenter(transform.position, transform.scale), EntityType::Platform, platform.toBits())});
 }
 
-void DoodleGame::SpawnPlatform(float xPosition, float yPosition) {
-    const std::string platformPath[] = {
-         "Platform 1.png",
-         "Platform 2.png",
-         "Platform 3.png",
-         "Platform 4.png",
-         "Platform 5.png"
-    };
-    float gameWidth{camera.scale.x};
-    gameObjects.push_back(std::make_unique<Platform>(
-            glm::vec2{xPosition, yPosition},
-            platformScale,
-            engine.getTextureId(platformPath[rand()%5])));
+void DoodleGame::AppendPlatforms(LevelChunk const& chunk) {
+    for (uint32_t i = 0; i < chunk.count; ++i)
+        SpawnPlatform(chunk.platforms[i]);
+    streamedTop = chunk.top;
 }
 
-bool DoodleGame::IsPlayerTouchingPlatform(GameObject const& platform) {
-    Player &player{getPlayer()};
-    if(player.velocity.y >= 0)
-        return false;
-    glm::vec2 playerMin{player.position - player.scale/2.f};
-    glm::vec2 playerMax{player.position + player.scale/2.f};
-    glm::vec2 platformMin{platform.position - platform.scale/2.f};
-    glm::vec2 platformMax{platform.position + platform.scale/2.f};
-    return (player.prevPos.y - player.scale.y/2.f) > platformMax.y
-        && SimpleAABB(playerMin,playerMax,platformMin,platformMax);
-}
-bool DoodleGame::SimpleAABB(glm::vec2 aMin, glm::vec2 aMax, glm::vec2 bMin, glm::vec2 bMax){
-    if(aMin.x > bMax.x || aMin.y > bMax.y)
-        return false;
-    if(aMax.x < bMin.x || aMax.y < bMin.y)
+void DoodleGame::StreamPlatforms() {
+    // keep one chunk ready above the top of the screen.
+    float const screenTop = camera.position.y + camera.scale.y / 2.f;
+    LevelChunk chunk;
+    while (streamedTop < screenTop + LevelStreamer::chunkHeight) {
+        // a chunk is a few microseconds of work, when the job is behind this thread picks it up
+        // rather than spawning a frame late. platforms start moving when they spawn, so spawning on
+        // time is what keeps a seed replaying the same however busy the workers are.
+        level.waitNext(chunk);
+        AppendPlatforms(chunk);
+    }
+}
+
+void DoodleGame::DespawnPlatforms(float belowY) {
+    world.forEach<Transform const, PlatformInfo const>([&](Entity platform, Transform const& transform, PlatformInfo const&) {
+        if (transform.position.y + transform.scale.y / 2 >= belowY)
+            return;
+        // crumbled platforms have left the broadphase already.
+        Collider const* collider = world.get<Collider>(platform);
+        if (collider && collider->proxy != invalidProxy)
+            broadphase.remove(collider->proxy);
+        commands.destroy(platform);
+    });
+}
+
+void DoodleGame::ClearObjects() {
+    // commands still queued refer to the old run's entities, apply() drops them.
+    world.clear();
+    broadphase.clear();
+    player = Entity{};
+    background = Entity{};
+}
+
+void DoodleGame::OnPlayerPlatform(void* context, Broadphase const& broadphase, ProxyId player, ProxyId platform) {
+    auto& game = *static_cast<DoodleGame*>(context);
+    Entity const platformEntity = Entity::fromBits(broadphase.userOf(platform));
+    Transform const& playerTransform = *game.world.get<Transform>(Entity::fromBits(broadphase.userOf(player)));
+    Transform const& platformTransform = *game.world.get<Transform>(platformEntity);
+    PlatformInfo const& platformInfo = *game.world.get<PlatformInfo>(platformEntity);
+    float time;
+    if (PlayerLandsOn(playerTransform, game.sweepFrom, platformTransform, platformInfo, time) && time <= game.landingTime) {
+        game.landingTime = time;
+        game.landingPlatform = platformEntity;
+    }
+}
+
+bool DoodleGame::PlayerLandsOn(Transform const& player, glm::vec2 from, Transform const& platform,
+                               PlatformInfo const& info, float& time) {
+    SweepHit hit{};
+    // platforms are one way, only their top stops a falling player. moving platforms are swept in
+    // their frame, from where they started the step.
+    if (!sweep(AABB::fromCenter(from, player.scale), player.position - from - info.displacement,
+               AABB::fromCenter(platform.position - info.displacement, platform.scale), hit)
+        || hit.normal.y <= 0.f)
         return false;
+    time = hit.time;
     return true;
 }
 
-void DoodleGame::PlayerJump() {
-    Player &player{getPlayer()};
-    player.velocity.y = player.jumpVelocity;
+void DoodleGame::PlayerJump(float boost) {
+    Transform const& transform = *world.get<Transform>(player);
+    PlayerMotion& motion = *world.get<PlayerMotion>(player);
+    motion.velocity.y = PlayerTuning::jumpVelocity * boost;
+    particles.emit(boost > 1.f ? springEmitter : bounceEmitter,
+                   transform.position - glm::vec2{0.f, transform.scale.y / 2.f});
     // Everytime we jump, roll a 101 dice[0-100]
-    int roll = rand() % 101;
-    if(roll <= player.rotationChance)
-        player.currentRotationTime = player.maxRotationTime;
-}
-
-Background& DoodleGame::getCurrentBackground() {
-    return *dynamic_cast<Background*>(gameObjects[backgroundIndex].get());
+    if(static_cast<int>(random.nextBelow(101)) <= PlayerTuning::rotationChance)
+        motion.rotationTime = PlayerTuning::maxRotationTime;
 }
 
 void DoodleGame::updateUI(float deltaTime) {
@@ -102,10 +285,10 @@ void DoodleGame::updateUI(float deltaTime) {
     //game loops keeps running, reference error if engine has not init on start screen.
     if(gameState == GameState::Playing) {
         //calculate top score
-        float currentHeight = (getPlayer().position.y - basePos.y) * 0.5f;
-        score = std::max(score, currentHeight);
+        height = (world.get<Transform>(player)->position.y - basePos.y) * 0.5f;
+        score = std::max(score, height);
 
-        JNI_UpdateScore(engine.app_, static_cast<int>(score));
+        events.publishScore(static_cast<int32_t>(score));
     }
 }
 
@@ -116,120 +299,156 @@ void DoodleGame::StartGame() {
 
 
 void DoodleGame::InitPlay() {
-    gameObjects.clear();
-    nextPlatformSpawn = 400;
+    runSeed = fixedSeed != 0 ? fixedSeed : static_cast<uint64_t>(Clock::monotonicNs());
+    random.reseed(runSeed);
+    LOGI("run seed %llu", static_cast<unsigned long long>(runSeed));
+
+    ClearObjects();
+    particles.clear();
+    particles.reseed(runSeed);
     camera.position = glm::vec2{0,0};
     // create player..
-    playerIndex = static_cast<int>(gameObjects.size());
-    gameObjects.push_back(std::make_unique<Player>(
-            glm::vec2{0,-camera.scale.y/2.f + 120},
-            glm::vec2{ 150, 150 },
-            engine.getTextureId("Player.png")
-    ));
-    getPlayer().prevPos = getPlayer().position;
+    // made right away rather than through `commands`, the first jump below needs it.
+    Transform const playerTransform{glm::vec2{0,-camera.scale.y/2.f + 120}, glm::vec2{ 150, 150 }};
+    player = world.create(
+            playerTransform,
+            Sprite{glm::vec4{1.f}, host.getTextureId("Player.png"), EntityType::Player},
+            PlayerMotion{glm::vec2{0.f}, playerTransform.position},
+            Collider{}
+    );
+    world.get<Collider>(player)->proxy = broadphase.add(
+            AABB::fromCenter(playerTransform.position, playerTransform.scale), EntityType::Player, player.toBits());
     // Create Background
-    backgroundIndex = static_cast<int>(gameObjects.size());
-    gameObjects.push_back(std::make_unique<Background>(
-            glm::vec2{0,0},
-            glm::vec2{camera.scale.x,camera.scale.y * 3.f},
-            engine.getTextureId("Scrolling Background.png")
-    ));
-    // Starting Platform
-    SpawnPlatform(0, -camera.scale.y/2.f);
-    (gameObjects.end()-1)->get()->scale.x = camera.scale.x;
-    nextPlatformSpawn += gameObjects[playerIndex]->position.y;
+    background = world.create(
+            Transform{glm::vec2{0,0}, glm::vec2{camera.scale.x,camera.scale.y * 3.f}},
+            Sprite{glm::vec4{1.f}, host.getTextureId("Scrolling Background.png"), EntityType::Environment}
+    );
+    // Starting Platform, as wide as the screen
+    SpawnPlatform(PlatformDesc{0, -camera.scale.y/2.f, random.nextBelow(platformVariants)}, camera.scale.x);
+    // Layout of the rest of the run
+    LevelGenerator::Params levelParams;
+    levelParams.worldWidth = camera.scale.x;
+    levelParams.platformWidth = platformScale.x;
+    levelParams.spacing = distanceBetweenPlatforms;
+    levelParams.variants = platformVariants;
+    streamedTop = playerTransform.position.y + firstPlatformOffset;
+    level.restart(levelParams, runSeed, streamedTop);
     PlayerJump();
 
     isGameOver = false;
     //UI init
     score = 0;
-    basePos = getPlayer().position;
+    height = 0;
+    basePos = playerTransform.position;
     gameState = GameState::Playing;
-    engine.playAudio("BGM.mp3", true);
+    host.playMusic(bgmSound);
 }
 
 void DoodleGame::PlayTime(float deltaTime) {
-    Player &player{getPlayer()};
-    float gameWidth{camera.scale.x};
-    float gameHeight{camera.scale.y};
-
-    // Update Player Velocity and Position
-    player.velocity.x +=
-            deltaTime * -engine.GetAccelerometerAcceleration().x * player.movementAcceleration;
-    player.velocity.x = std::clamp(player.velocity.x, -player.maxMovementSpeed,
-                                   player.maxMovementSpeed);
-    player.velocity.y += deltaTime * -gravity;
-    player.position += deltaTime * player.velocity;
-    float playerScreenXmin = -gameWidth / 2.f + player.scale.x / 2.f;
-    float playerScreenXmax = gameWidth / 2.f - player.scale.x / 2.f;
-    player.position.x = std::clamp(player.position.x, playerScreenXmin, playerScreenXmax);
-
-    // Wrap around
-    if (player.velocity.x < 0 && player.position.x <= playerScreenXmin)
-        player.position.x = playerScreenXmax;
-    else if (player.velocity.x > 0 && player.position.x >= playerScreenXmax)
-        player.position.x = playerScreenXmin;
+    // Platforms move first, the player lands on where they are at the end of the step
+    behaviours.update(world, deltaTime, broadphase, commands);
 
-    // Jump
-    for (int i{}; i < gameObjects.size(); ++i) {
-        GameObject &go{*gameObjects[i]};
-        if (go.getType() != GameObjectType::Platform)
-            continue;
-        if (IsPlayerTouchingPlatform(go)) {
-            PlayerJump();
-            break;
-        }
-    }
-    player.prevPos = player.position;
-
-    // Rotation
-    player.currentRotationTime = std::max(0.f, player.currentRotationTime - deltaTime);
-    player.rotation = Utils::Lerp(
-            std::signbit(player.velocity.x) ? 360 : -360,
-            0,
-            player.currentRotationTime / player.maxRotationTime
-    );
+    MovePlayer(deltaTime);
+    CollidePlayer();
+    RotatePlayer(deltaTime);
 
     // Increase Camera Height
-    if (player.position.y > camera.position.y)
-        camera.position.y = player.position.y;
+    Transform const& playerTransform = *world.get<Transform>(player);
+    if (playerTransform.position.y > camera.position.y)
+        camera.position.y = playerTransform.position.y;
 
     // Platform despawning
-    auto canDespawnPlatform = [&](std::unique_ptr<GameObject> const &go) {
-        if (go->getType() != GameObjectType::Platform)
-            return false;
-        float platformMaxY = go->position.y + go->scale.y / 2;
-        return platformMaxY < camera.position.y - gameHeight / 2;
-    };
-    std::vector<std::unique_ptr<GameObject>>::iterator iter
-            = std::remove_if(std::begin(gameObjects), std::end(gameObjects),
-                             canDespawnPlatform);
-    if (iter != gameObjects.end())
-        gameObjects.erase(iter, gameObjects.end());
+    DespawnPlatforms(camera.position.y - camera.scale.y / 2);
 
     // Platform spawning
-    for (nextPlatformSpawn; nextPlatformSpawn < camera.position.y + gameHeight /
-                                                                    2; nextPlatformSpawn += distanceBetweenPlatforms) {
-        float randomX = rand() % static_cast<int>(gameWidth - platformScale.x) - gameWidth / 2 +
-                        platformScale.x / 2;
-        SpawnPlatform(randomX, nextPlatformSpawn);
-    }
+    StreamPlatforms();
 
 
     // Scrolling Background
-    Background &background = getCurrentBackground();
-    if (background.position.y <= camera.position.y - camera.scale.y / 2.f) {
-        background.position.y += camera.scale.y;
+    Transform& backgroundTransform = *world.get<Transform>(background);
+    if (backgroundTransform.position.y <= camera.position.y - camera.scale.y / 2.f) {
+        backgroundTransform.position.y += camera.scale.y;
     }
 
     //Set game over state if player falls below the screen
-    if (!isGameOver && player.position.y < camera.position.y - camera.scale.y / 2.f) {
+    if (!isGameOver && playerTransform.position.y < camera.position.y - camera.scale.y / 2.f) {
         isGameOver = true;
-        JNI_GameOver(engine.app_, static_cast<int>(score));
+        events.publishGameOver(static_cast<int32_t>(score));
         gameState = GameState::GameOver;
-        engine.playAudio("GameOverBGM.mp3", true);
+        host.playMusic(gameOverSound);
+        // the player is already out of sight, the burst comes up from the bottom edge.
+        particles.emit(gameOverEmitter, glm::vec2{playerTransform.position.x, camera.position.y - camera.scale.y / 2.f});
     }
 }
+
+void DoodleGame::MovePlayer(float deltaTime) {
+    float const gameWidth{camera.scale.x};
+    // the tilt is already extrapolated to this frame's present time by the host.
+    float const tilt = -host.GetAccelerometerAcceleration().x;
+    world.forEach<Transform, PlayerMotion>([&](Entity, Transform& transform, PlayerMotion& motion) {
+        // Update Player Velocity and Position
+        motion.velocity.x += deltaTime * tilt * PlayerTuning::movementAcceleration;
+        motion.velocity.x = std::clamp(motion.velocity.x, -PlayerTuning::maxMovementSpeed,
+                                       PlayerTuning::maxMovementSpeed);
+        motion.velocity.y += deltaTime * -gravity;
+        transform.position += deltaTime * motion.velocity;
+        float playerScreenXmin = -gameWidth / 2.f + transform.scale.x / 2.f;
+        float playerScreenXmax = gameWidth / 2.f - transform.scale.x / 2.f;
+        transform.position.x = std::clamp(transform.position.x, playerScreenXmin, playerScreenXmax);
+
+        // Wrap around
+        if (motion.velocity.x < 0 && transform.position.x <= playerScreenXmin)
+            transform.position.x = playerScreenXmax;
+        else if (motion.velocity.x > 0 && transform.position.x >= playerScreenXmax)
+            transform.position.x = playerScreenXmin;
+    });
+}
+
+void DoodleGame::CollidePlayer() {
+    Transform& transform = *world.get<Transform>(player);
+    PlayerMotion& motion = *world.get<PlayerMotion>(player);
+    // Jump
+    // the player's box is swept over the whole step, so no frame is long enough to fall through a
+    // platform. the broadphase picks the platforms the sweep's bounds touch, OnPlayerPlatform keeps
+    // the earliest hit.
+    if (motion.velocity.y < 0) {
+        sweepFrom = motion.prevPos;
+        // a wrap around teleports the player, only sweep the vertical part of that step.
+        if (std::fabs(transform.position.x - sweepFrom.x) > camera.scale.x / 2.f)
+            sweepFrom.x = transform.position.x;
+        AABB const start = AABB::fromCenter(sweepFrom, transform.scale);
+        AABB const end = AABB::fromCenter(transform.position, transform.scale);
+        broadphase.update(world.get<Collider>(player)->proxy,
+                          AABB{glm::min(start.min, end.min), glm::max(start.max, end.max)});
+
+        landingTime = 1.f;
+        landingPlatform = Entity{};
+        broadphase.findPairs(host.getJobs());
+        narrowphase.dispatch(broadphase);
+        if (landingPlatform.valid()) {
+            Transform const& platform = *world.get<Transform>(landingPlatform);
+            PlatformInfo const& info = *world.get<PlatformInfo>(landingPlatform);
+            // bounce from the contact, not from wherever the step ended.
+            transform.position.y = platform.position.y + platform.scale.y / 2.f + transform.scale.y / 2.f;
+            if (info.kind == PlatformKind::Crumbling)
+                particles.emit(debrisEmitters[info.variant], platform.position);
+            PlayerJump(behaviours.land(world, landingPlatform, broadphase, commands));
+        }
+    }
+    motion.prevPos = transform.position;
+}
+
+void DoodleGame::RotatePlayer(float deltaTime) {
+    world.forEach<Transform, PlayerMotion>([&](Entity, Transform& transform, PlayerMotion& motion) {
+        motion.rotationTime = std::max(0.f, motion.rotationTime - deltaTime);
+        transform.rotation = Utils::Lerp(
+                std::signbit(motion.velocity.x) ? 360 : -360,
+                0,
+                motion.rotationTime / PlayerTuning::maxRotationTime
+        );
+    });
+}
+
 void DoodleGame::ResetGame() {
     gameState = GameState::Start;
 }
@@ -7,74 +7,150 @@
 
 #include <vector>
 #include <memory>
-#include "GameObject/GameObject.h"
+#include "Components.h"
+#include "Ecs/World.h"
+#include "Ecs/CommandBuffer.h"
+#include "../Audio/AudioHandles.h"
+#include "../Core/Random.h"
+#include "LevelStreamer.h"
+#include "PlatformBehaviours.h"
+#include "Particles/ParticleSystem.h"
+#include "Collision/Broadphase.h"
 
 class Camera;
-class Player;
-class Engine;
-class Background;
+class GameHost;
+class UiEventChannel;
 
 class DoodleGame {
 public:
-    explicit DoodleGame(Engine& engine, Camera& camera);
+    // score and state changes are published on `events`, the engine passes the process wide uiEvents().
+    DoodleGame(GameHost& host, Camera& camera, UiEventChannel& events);
 
 public:
     void update(float deltaTime);
     void updateUI(float deltaTime);
-
-    // retrieve all game objects..
-    std::vector<std::unique_ptr<GameObject>> const& getGameObjects();
-
-    // get player..
-    // Doodle Game assumes that there is always one valid player, if not it segfaults.
-    // if you want error handling, change it to pointer.
-    Player& getPlayer();
-    Background& getCurrentBackground();
+    // resolve every sound the game plays up front, so state changes only pass ids around.
+    void preloadAudio();
+
+    // every entity of the run. the renderer draws whatever has a Transform and a Sprite.
+    World& getWorld() { return world; }
+    World const& getWorld() const { return world; }
+    // effects, drawn after the platforms.
+    ParticleSystem const& getParticles() const { return particles; }
+
+    // the player and background of the current run, invalid before the first one starts.
+    Entity getPlayer() const { return player; }
+    Entity getBackground() const { return background; }
+
+    // best and current height of this run, in score units.
+    float getScore() const { return score; }
+    float getHeight() const { return height; }
+
+    // pins the seed of the following runs, so they replay exactly. 0 picks a fresh seed per run.
+    // must be called before StartGame.
+    void setSeed(uint64_t seed) { fixedSeed = seed; }
+    uint64_t getRunSeed() const { return runSeed; }
+
+    float getGravity() const { return gravity; }
+    Camera const& getCamera() const { return camera; }
 public:
-    void SpawnPlatform(float xPosition, float yPosition);
-    bool IsPlayerTouchingPlatform(GameObject const& platform);
-    bool SimpleAABB(glm::vec2 aMin, glm::vec2 aMax, glm::vec2 bMin, glm::vec2 bMax);
-    void PlayerJump();
+    // queued on `commands`, the platform shows up when they're applied at the end of the frame.
+    // `width` 0 is the regular platform width.
+    void SpawnPlatform(PlatformDesc const& desc, float width = 0.f);
+    void AppendPlatforms(LevelChunk const& chunk);
+    void StreamPlatforms();
+    void DespawnPlatforms(float belowY);
+    void ClearObjects();
+    void AddEmitters();
+    static void OnPlayerPlatform(void* context, Broadphase const& broadphase, ProxyId player, ProxyId platform);
+    // time of impact (0..1) of the player's move from `from` onto the top of the platform, relative
+    // to the platform's own move this step.
+    static bool PlayerLandsOn(Transform const& player, glm::vec2 from, Transform const& platform,
+                              PlatformInfo const& info, float& time);
+    // the player systems, steering and gravity, then landing on platforms, then the flip.
+    void MovePlayer(float deltaTime);
+    void CollidePlayer();
+    void RotatePlayer(float deltaTime);
+    // `boost` scales the jump velocity, springs throw the player higher.
+    void PlayerJump(float boost = 1.f);
     void StartGame();
     void InitPlay();
     void PlayTime(float deltaTime);
     void ResetGame();
 
 public:
+    // values are mirrored in MainActivity.
     enum class GameState{
         Awake,
         Start,
         Playing,
         GameOver
     };
+    GameState getState() const { return gameState; }
 
 private:
 
+    static constexpr uint32_t platformVariants = 5;
     const glm::vec2 platformScale = glm::vec2{ 175, 20 };
-    // unique pointer for polymorphism.
-    std::vector<std::unique_ptr<GameObject>> gameObjects;
-    // holds the index of the player game object in the array of gameObjects..
-    int playerIndex;
-    int backgroundIndex;
+    GLuint platformTextures[platformVariants];
+    // every entity of the run. archetypes and the command buffer are reserved up front, so a
+    // gameplay frame never allocates. systems queue structural changes on `commands`, which is
+    // applied at the end of every update.
+    World              world;
+    CommandBuffer      commands;
+    // moves the platforms that aren't static, kind by kind.
+    PlatformBehaviours behaviours;
+
+    // Collision
+    Broadphase            broadphase;
+    NarrowphaseDispatcher narrowphase;
+    // the player's sweep this step and the earliest platform it hits, filled in by OnPlayerPlatform.
+    glm::vec2             sweepFrom;
+    float                 landingTime;
+    Entity                landingPlatform;
+    // the player and background of the current run.
+    Entity player;
+    Entity background;
     // reference to renderer's camera.
     Camera& camera;
     glm::vec2 cameraPos;
 
 
-    // reference to engine.
-    Engine& engine;
+    // whoever runs the game, the engine on a device.
+    GameHost& host;
+    UiEventChannel& events;
 
     // Game Stuff
-    float nextPlatformSpawn;
     float gravity;
     float distanceBetweenPlatforms;
     bool  isGameOver;
     bool  hasGameRunOnce;
 
+    // every random decision of a run comes from here, reseeded in InitPlay. the layout comes from
+    // the level streamer, seeded with the same run seed.
+    Random   random;
+    LevelStreamer level;
+    float    streamedTop;   // every platform below this has been spawned
+    uint64_t fixedSeed;
+    uint64_t runSeed;
+
     GameState gameState;
+    GameState publishedState;   // last state reported to the UI
+
+    // Effects
+    ParticleSystem particles;
+    EmitterId bounceEmitter;
+    EmitterId springEmitter;
+    EmitterId debrisEmitters[platformVariants];
+    EmitterId gameOverEmitter;
+
+    // Audio
+    SoundId bgmSound;
+    SoundId gameOverSound;
 
     //UI Tracking
     float score;
+    float height;
     glm::vec2 basePos;
 
 };
@@ -0,0 +1,54 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "CommandBuffer.h"
+
+void CommandBuffer::reserve(std::size_t commandCount, std::size_t bytes) {
+    commands.reserve(commandCount);
+    data.reserve(bytes);
+}
+
+void CommandBuffer::destroy(Entity entity) {
+    commands.push_back(Command{Op::Destroy, 0, entity, 0, 0, 0});
+}
+
+void CommandBuffer::apply(World& world) {
+    std::size_t i = 0;
+    while (i < commands.size()) {
+        Command const& command = commands[i];
+        if (command.op == Op::Destroy) {
+            world.destroy(command.entity);
+            ++i;
+            continue;
+        }
+        // the run of adds and removes on this entity, as one move.
+        ComponentMask add = 0;
+        ComponentMask remove = 0;
+        std::size_t end = i;
+        for (; end < commands.size() && commands[end].op != Op::Destroy && commands[end].entity == command.entity; ++end) {
+            ComponentMask const bit = ComponentMask{1} << commands[end].component;
+            if (commands[end].op == Op::Add) {
+                world.registerComponent(commands[end].component, commands[end].size, commands[end].align);
+                add |= bit;
+                remove &= ~bit;
+            }
+            else {
+                remove |= bit;
+                add &= ~bit;
+            }
+        }
+        world.restructure(command.entity, add, remove);
+        // values in queue order, the last add of a component wins.
+        for (std::size_t j = i; j < end; ++j) {
+            Command const& value = commands[j];
+            if (value.op != Op::Add || (add & (ComponentMask{1} << value.component)) == 0)
+                continue;
+            if (void* target = world.componentData(command.entity, value.component))
+                std::memcpy(target, data.data() + value.offset, value.size);
+        }
+        i = end;
+    }
+    commands.clear();
+    data.clear();
+}
@@ -0,0 +1,75 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_COMMANDBUFFER_H
+#define DOODLE_COMMANDBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "World.h"
+
+/*!
+ * Structural changes queued while systems iterate the World, applied in order by apply() at the
+ * end of the frame.
+ *
+ * create() hands out a live entity right away, so commands can refer to it, it only gets its
+ * components on apply(). Consecutive adds and removes on the same entity become one move to their
+ * final archetype, so spawning with several components costs one row copy, not one per component.
+ * Commands on an entity that's gone by then are dropped.
+ *
+ * Component values are copied into a byte buffer. Both buffers keep their capacity, reserve() them
+ * and queueing doesn't allocate.
+ */
+class CommandBuffer {
+public:
+    void reserve(std::size_t commands, std::size_t bytes);
+
+    Entity create(World& world) { return world.create(); }
+    template <typename T>
+    void add(Entity entity, T const& component);
+    template <typename T>
+    void remove(Entity entity);
+    void destroy(Entity entity);
+
+    void apply(World& world);
+    bool empty() const { return commands.empty(); }
+
+private:
+    enum class Op : uint8_t {
+        Add,
+        Remove,
+        Destroy
+    };
+    struct Command {
+        Op          op;
+        ComponentId component;
+        Entity      entity;
+        uint32_t    offset;      // of an added value in `data`
+        uint32_t    size;
+        uint32_t    align;
+    };
+
+    std::vector<Command>   commands;
+    std::vector<std::byte> data;
+};
+
+template <typename T>
+void CommandBuffer::add(Entity entity, T const& component) {
+    static_assert(std::is_trivially_copyable_v<T>, "components are copied with memcpy");
+    auto const offset = static_cast<uint32_t>(data.size());
+    auto const* bytes = reinterpret_cast<std::byte const*>(&component);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+    commands.push_back(Command{Op::Add, T::componentId, entity, offset, sizeof(T), alignof(T)});
+}
+
+template <typename T>
+void CommandBuffer::remove(Entity entity) {
+    commands.push_back(Command{Op::Remove, T::componentId, entity, 0, 0, 0});
+}
+
+#endif //DOODLE_COMMANDBUFFER_H
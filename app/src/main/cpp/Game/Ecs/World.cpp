@@ -0,0 +1,187 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "World.h"
+
+namespace {
+    std::size_t alignUp(std::size_t value, std::size_t align) {
+        return (value + align - 1) & ~(align - 1);
+    }
+}
+
+World::World(std::size_t chunkBytes) :
+        chunkBytes { chunkBytes }
+{
+    // index 0, where entities wait for their first components.
+    archetypeFor(0);
+}
+
+World::~World() = default;
+
+Entity World::create() {
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+    Entity const entity{index, records[index].generation};
+    records[index].archetype = 0;
+    records[index].row = appendRow(*archetypes.front(), entity);
+    ++live;
+    return entity;
+}
+
+void World::destroy(Entity entity) {
+    assert(iterating == 0 && "structural change during a query, use a CommandBuffer");
+    if (!isLive(entity))
+        return;
+    Record& record = records[entity.index];
+    removeRow(*archetypes[record.archetype], record.row);
+    record.archetype = noArchetype;
+    ++record.generation;
+    freeIndices.push_back(entity.index);
+    --live;
+}
+
+bool World::alive(Entity entity) const {
+    return isLive(entity);
+}
+
+void World::clear() {
+    assert(iterating == 0 && "structural change during a query, use a CommandBuffer");
+    for (auto& archetype : archetypes)
+        archetype->size = 0;
+    // lowest index on top, so the next fill reuses indices in order.
+    freeIndices.clear();
+    for (std::size_t i = records.size(); i-- > 0;) {
+        Record& record = records[i];
+        if (record.archetype != noArchetype) {
+            record.archetype = noArchetype;
+            ++record.generation;
+        }
+        freeIndices.push_back(static_cast<uint32_t>(i));
+    }
+    live = 0;
+}
+
+void World::reserveEntities(std::size_t count) {
+    records.reserve(count);
+    freeIndices.reserve(count);
+    // new entities sit in the empty archetype until a command buffer fills them in.
+    growChunks(*archetypes.front(), count);
+}
+
+void World::registerComponent(ComponentId id, std::size_t size, std::size_t align) {
+    assert(id < maxComponents);
+    ComponentInfo& info = components[id];
+    assert((info.size == 0 || info.size == size) && "two components share an id");
+    info.size = static_cast<uint32_t>(size);
+    info.align = static_cast<uint32_t>(align);
+}
+
+ComponentMask World::maskOf(Entity entity) const {
+    return isLive(entity) ? archetypes[records[entity.index].archetype]->mask : 0;
+}
+
+void World::restructure(Entity entity, ComponentMask add, ComponentMask remove) {
+    assert(iterating == 0 && "structural change during a query, use a CommandBuffer");
+    if (!isLive(entity))
+        return;
+    Record& record = records[entity.index];
+    Archetype& source = *archetypes[record.archetype];
+    ComponentMask const mask = (source.mask | add) & ~remove;
+    if (mask == source.mask)
+        return;
+    uint32_t const target = indexOf(mask);
+    // indexOf may have grown `archetypes`, archetypes themselves don't move.
+    Archetype& destination = *archetypes[target];
+    uint32_t const row = appendRow(destination, entity);
+    for (ComponentMask shared = source.mask & mask; shared != 0; shared &= shared - 1) {
+        auto const id = static_cast<ComponentId>(__builtin_ctzll(shared));
+        std::memcpy(componentOf(destination, row, id), componentOf(source, record.row, id), components[id].size);
+    }
+    removeRow(source, record.row);
+    record.archetype = target;
+    record.row = row;
+}
+
+void* World::componentData(Entity entity, ComponentId id) {
+    if (!isLive(entity))
+        return nullptr;
+    Record const& record = records[entity.index];
+    Archetype& archetype = *archetypes[record.archetype];
+    if ((archetype.mask & (ComponentMask{1} << id)) == 0)
+        return nullptr;
+    return componentOf(archetype, record.row, id);
+}
+
+World::Archetype& World::archetypeFor(ComponentMask mask) {
+    return *archetypes[indexOf(mask)];
+}
+
+uint32_t World::indexOf(ComponentMask mask) {
+    // a handful of archetypes in this game, a linear search beats a map.
+    for (std::size_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i]->mask == mask)
+            return static_cast<uint32_t>(i);
+    }
+    assert(iterating == 0 && "new archetype during a query");
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->mask = mask;
+    // as many rows as fit with every column padded to its alignment, at least one.
+    std::size_t rowBytes = sizeof(Entity);
+    std::size_t padding = 0;
+    for (ComponentMask bits = mask; bits != 0; bits &= bits - 1) {
+        ComponentInfo const& info = components[__builtin_ctzll(bits)];
+        assert(info.size != 0 && "component used before it was registered");
+        rowBytes += info.size;
+        padding += info.align;
+    }
+    archetype->capacity = chunkBytes > padding + rowBytes ? (chunkBytes - padding) / rowBytes : 1;
+    std::size_t offset = archetype->capacity * sizeof(Entity);
+    for (ComponentMask bits = mask; bits != 0; bits &= bits - 1) {
+        auto const id = static_cast<ComponentId>(__builtin_ctzll(bits));
+        offset = alignUp(offset, components[id].align);
+        archetype->columnOffset[id] = static_cast<uint32_t>(offset);
+        offset += archetype->capacity * components[id].size;
+    }
+    archetype->chunkBytes = std::max(chunkBytes, offset);
+    archetypes.push_back(std::move(archetype));
+    return static_cast<uint32_t>(archetypes.size() - 1);
+}
+
+void World::growChunks(Archetype& archetype, std::size_t rows) {
+    std::size_t const chunks = (archetype.size + rows + archetype.capacity - 1) / archetype.capacity;
+    archetype.chunks.reserve(chunks);
+    while (archetype.chunks.size() < chunks)
+        archetype.chunks.emplace_back(new std::byte[archetype.chunkBytes]);
+}
+
+uint32_t World::appendRow(Archetype& archetype, Entity entity) {
+    std::size_t const row = archetype.size;
+    if (row == archetype.chunks.size() * archetype.capacity)
+        archetype.chunks.emplace_back(new std::byte[archetype.chunkBytes]);
+    entitiesOf(archetype, row / archetype.capacity)[row % archetype.capacity] = entity;
+    ++archetype.size;
+    return static_cast<uint32_t>(row);
+}
+
+void World::removeRow(Archetype& archetype, uint32_t row) {
+    auto const last = static_cast<uint32_t>(archetype.size - 1);
+    if (row != last) {
+        Entity const moved = entitiesOf(archetype, last / archetype.capacity)[last % archetype.capacity];
+        entitiesOf(archetype, row / archetype.capacity)[row % archetype.capacity] = moved;
+        for (ComponentMask bits = archetype.mask; bits != 0; bits &= bits - 1) {
+            auto const id = static_cast<ComponentId>(__builtin_ctzll(bits));
+            std::memcpy(componentOf(archetype, row, id), componentOf(archetype, last, id), components[id].size);
+        }
+        records[moved.index].row = row;
+    }
+    --archetype.size;
+}
@@ -0,0 +1,304 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_WORLD_H
+#define DOODLE_WORLD_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using ComponentId = uint32_t;
+using ComponentMask = uint64_t;
+constexpr std::size_t maxComponents = 64;     // one bit each in a ComponentMask
+
+// an entity's index and the generation of that index, so a stale id never resolves to whatever
+// reused the slot.
+struct Entity {
+    static constexpr uint32_t invalidIndex = UINT32_MAX;
+
+    uint32_t index{invalidIndex};
+    uint32_t generation{0};
+
+    bool valid() const { return index != invalidIndex; }
+    bool operator==(Entity other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(Entity other) const { return !(*this == other); }
+
+    // packed, for places that carry an opaque 64 bit value, like the broadphase's user data.
+    uint64_t toBits() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static Entity fromBits(uint64_t bits) {
+        return Entity{static_cast<uint32_t>(bits), static_cast<uint32_t>(bits >> 32)};
+    }
+};
+
+template <typename T>
+constexpr ComponentMask componentBit() {
+    static_assert(std::remove_const_t<T>::componentId < maxComponents, "component id out of range");
+    return ComponentMask{1} << std::remove_const_t<T>::componentId;
+}
+
+template <typename... Ts>
+constexpr ComponentMask componentMask() {
+    return (ComponentMask{0} | ... | componentBit<Ts>());
+}
+
+// the columns of one chunk of a query, see World::forEachChunk. column<T>() has the constness T
+// was queried with.
+template <typename... Ts>
+struct ChunkView {
+    std::size_t   count;
+    Entity const* entities;
+    void*         columns[sizeof...(Ts)];
+
+    template <typename T>
+    auto* column() const {
+        constexpr std::size_t index = indexOf<std::remove_const_t<T>>();
+        using Queried = std::tuple_element_t<index, std::tuple<Ts...>>;
+        return static_cast<Queried*>(columns[index]);
+    }
+
+private:
+    template <typename T>
+    static constexpr std::size_t indexOf() {
+        constexpr bool matches[] = {std::is_same_v<T, std::remove_const_t<Ts>>...};
+        for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+            if (matches[i])
+                return i;
+        }
+        return sizeof...(Ts);
+    }
+};
+
+/*!
+ * Archetype entity storage.
+ *
+ * Entities with the same set of components share an archetype, which stores them in fixed size
+ * chunks: the entity ids, then one contiguous column per component, in component id order. Rows
+ * are dense, removing one moves the archetype's last row into it, so a query streams through full
+ * columns and never sees a hole. Adding or removing a component moves the entity's row to the
+ * archetype of its new set.
+ *
+ * Components are plain data, copied with memcpy, each with a unique `static constexpr ComponentId
+ * componentId` below maxComponents (see Game/Components.h). They're registered by the first call
+ * that names them.
+ *
+ * Structural changes (add, remove, destroy) are not allowed while a query runs, systems queue them
+ * on a CommandBuffer instead. create() is, the entity has no components and no query sees it until
+ * the buffer fills it in.
+ *
+ * Archetypes and chunks are never freed, clear() only empties them, so a world reserve()d up front
+ * doesn't allocate in steady state.
+ */
+class World {
+public:
+    static constexpr std::size_t defaultChunkBytes = 16 * 1024;
+
+    explicit World(std::size_t chunkBytes = defaultChunkBytes);
+    ~World();
+
+    World(World const&) = delete;
+    World& operator=(World const&) = delete;
+
+    // an entity without components.
+    Entity create();
+    template <typename... Ts>
+    Entity create(Ts const&... components);
+    void destroy(Entity entity);
+    bool alive(Entity entity) const;
+    // destroys every entity. archetypes keep their chunks for the next fill.
+    void clear();
+
+    template <typename T>
+    void add(Entity entity, T const& component);
+    template <typename T>
+    void remove(Entity entity);
+    // nullptr when the entity is gone or doesn't have one.
+    template <typename T>
+    T* get(Entity entity);
+    template <typename T>
+    T const* get(Entity entity) const;
+    template <typename T>
+    bool has(Entity entity) const { return (maskOf(entity) & componentBit<T>()) != 0; }
+
+    // room for `count` entities with exactly the components Ts.
+    template <typename... Ts>
+    void reserve(std::size_t count);
+    // room for `count` entity ids, live at once or waiting for a command buffer.
+    void reserveEntities(std::size_t count);
+
+    // f(ChunkView<Ts...>&) for every chunk of every archetype with at least the components Ts, in
+    // archetype creation order. const Ts are read only.
+    template <typename... Ts, typename F>
+    void forEachChunk(F&& f);
+    // f(Entity, Ts&...) for every matching entity, chunk by chunk.
+    template <typename... Ts, typename F>
+    void forEach(F&& f);
+    // matching entities, without visiting them.
+    template <typename... Ts>
+    std::size_t count() const;
+
+    std::size_t size() const { return live; }
+    std::size_t archetypeCount() const { return archetypes.size(); }
+
+    // type erased, for the CommandBuffer. registers the component if it's new.
+    void registerComponent(ComponentId id, std::size_t size, std::size_t align);
+    // the components of a live entity, 0 when it's gone.
+    ComponentMask maskOf(Entity entity) const;
+    // moves the entity to the archetype with `add` set and `remove` cleared, in one move. added
+    // components are left uninitialized.
+    void restructure(Entity entity, ComponentMask add, ComponentMask remove);
+    void* componentData(Entity entity, ComponentId id);
+
+private:
+    static constexpr uint32_t noArchetype = UINT32_MAX;
+    static constexpr std::size_t maxAlign = __STDCPP_DEFAULT_NEW_ALIGNMENT__;   // what a chunk allocation guarantees
+
+    struct ComponentInfo {
+        uint32_t size{0};
+        uint32_t align{0};
+    };
+    struct Archetype {
+        ComponentMask mask;
+        std::size_t   capacity;      // rows per chunk
+        std::size_t   chunkBytes;
+        std::size_t   size{0};       // rows in use, over all chunks
+        uint32_t      columnOffset[maxComponents];   // byte offset in a chunk, by component id
+        std::vector<std::unique_ptr<std::byte[]>> chunks;
+    };
+    struct Record {
+        uint32_t generation{0};
+        uint32_t archetype{noArchetype};   // noArchetype while the index is free
+        uint32_t row{0};
+    };
+
+    template <typename T>
+    void registerComponent() {
+        static_assert(std::is_trivially_copyable_v<T>, "components are copied with memcpy");
+        static_assert(alignof(T) <= maxAlign, "chunks are only aligned this far");
+        registerComponent(T::componentId, sizeof(T), alignof(T));
+    }
+
+    Archetype& archetypeFor(ComponentMask mask);
+    uint32_t   indexOf(ComponentMask mask);
+    void growChunks(Archetype& archetype, std::size_t rows);
+    // appends a row for `entity`, its components uninitialized.
+    uint32_t appendRow(Archetype& archetype, Entity entity);
+    // fills the row with the archetype's last one.
+    void removeRow(Archetype& archetype, uint32_t row);
+    Entity* entitiesOf(Archetype& archetype, std::size_t chunk) const {
+        return reinterpret_cast<Entity*>(archetype.chunks[chunk].get());
+    }
+    void* columnOf(Archetype& archetype, std::size_t chunk, ComponentId id) const {
+        return archetype.chunks[chunk].get() + archetype.columnOffset[id];
+    }
+    void* componentOf(Archetype& archetype, uint32_t row, ComponentId id) const {
+        return static_cast<std::byte*>(columnOf(archetype, row / archetype.capacity, id))
+                + (row % archetype.capacity) * components[id].size;
+    }
+    bool isLive(Entity entity) const {
+        return entity.index < records.size() && records[entity.index].generation == entity.generation
+                && records[entity.index].archetype != noArchetype;
+    }
+
+    std::size_t   chunkBytes;
+    ComponentInfo components[maxComponents]{};
+    std::vector<std::unique_ptr<Archetype>> archetypes;     // the empty archetype first
+    std::vector<Record>   records;                          // by entity index
+    std::vector<uint32_t> freeIndices;
+    std::size_t live{0};
+#ifndef NDEBUG
+    int iterating{0};    // queries running, structural changes assert on it
+#endif
+};
+
+template <typename... Ts>
+Entity World::create(Ts const&... components) {
+    Entity const entity = create();
+    if constexpr (sizeof...(Ts) > 0) {
+        (registerComponent<Ts>(), ...);
+        restructure(entity, componentMask<Ts...>(), 0);
+        ((*static_cast<Ts*>(componentData(entity, Ts::componentId)) = components), ...);
+    }
+    return entity;
+}
+
+template <typename T>
+void World::add(Entity entity, T const& component) {
+    registerComponent<T>();
+    restructure(entity, componentBit<T>(), 0);
+    if (void* data = componentData(entity, T::componentId))
+        *static_cast<T*>(data) = component;
+}
+
+template <typename T>
+void World::remove(Entity entity) {
+    restructure(entity, 0, componentBit<T>());
+}
+
+template <typename T>
+T* World::get(Entity entity) {
+    return static_cast<T*>(componentData(entity, T::componentId));
+}
+
+template <typename T>
+T const* World::get(Entity entity) const {
+    return const_cast<World*>(this)->get<T>(entity);
+}
+
+template <typename... Ts>
+void World::reserve(std::size_t count) {
+    (registerComponent<Ts>(), ...);
+    growChunks(archetypeFor(componentMask<Ts...>()), count);
+}
+
+template <typename... Ts, typename F>
+void World::forEachChunk(F&& f) {
+    static_assert(sizeof...(Ts) > 0, "a query needs at least one component");
+    constexpr ComponentMask required = componentMask<Ts...>();
+#ifndef NDEBUG
+    ++iterating;
+#endif
+    // by index, a create() in `f` may add to the empty archetype but never a new archetype.
+    for (std::size_t a = 0; a < archetypes.size(); ++a) {
+        Archetype& archetype = *archetypes[a];
+        if ((archetype.mask & required) != required)
+            continue;
+        for (std::size_t chunk = 0, first = 0; first < archetype.size; ++chunk, first += archetype.capacity) {
+            ChunkView<Ts...> view{std::min(archetype.capacity, archetype.size - first), entitiesOf(archetype, chunk),
+                                  {columnOf(archetype, chunk, std::remove_const_t<Ts>::componentId)...}};
+            f(view);
+        }
+    }
+#ifndef NDEBUG
+    --iterating;
+#endif
+}
+
+template <typename... Ts, typename F>
+void World::forEach(F&& f) {
+    forEachChunk<Ts...>([&](ChunkView<Ts...>& view) {
+        for (std::size_t i = 0; i < view.count; ++i)
+            f(view.entities[i], view.template column<Ts>()[i]...);
+    });
+}
+
+template <typename... Ts>
+std::size_t World::count() const {
+    constexpr ComponentMask required = componentMask<Ts...>();
+    std::size_t total = 0;
+    for (auto const& archetype : archetypes) {
+        if ((archetype->mask & required) == required)
+            total += archetype->size;
+    }
+    return total;
+}
+
+#endif //DOODLE_WORLD_H
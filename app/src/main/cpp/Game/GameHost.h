@@ -0,0 +1,38 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_GAMEHOST_H
+#define DOODLE_GAMEHOST_H
+
+#include <string>
+#include <glm/vec3.hpp>
+
+#include "Components.h"
+#include "../Audio/AudioHandles.h"
+
+class JobSystem;
+
+/*!
+ * What DoodleGame needs from whoever runs it: textures, sounds, the tilt input and the jobs.
+ *
+ * The Engine is the host on a device. Keeping the game behind this interface lets the host tools
+ * (see tools/headless) run any number of games without a window, GL or audio.
+ */
+class GameHost {
+public:
+    virtual ~GameHost() = default;
+
+    virtual GLuint getTextureId(std::string const& filepath) = 0;
+    virtual SoundId preloadSound(const char* path) = 0;
+    // switches the background music, the previous track is stopped.
+    virtual void playMusic(SoundId sound, bool loopBool = true) = 0;
+
+    // tilt for the frame being updated, in m/s^2 like the accelerometer. zero outside of gameplay.
+    virtual glm::vec3 GetAccelerometerAcceleration() const = 0;
+
+    // owned by the thread the game updates on, see Core/JobSystem.h.
+    virtual JobSystem& getJobs() = 0;
+};
+
+#endif //DOODLE_GAMEHOST_H
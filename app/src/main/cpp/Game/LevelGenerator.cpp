@@ -0,0 +1,52 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "LevelGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    PlatformKind kindOf(LevelGenerator::Params const& params, uint32_t roll) {
+        if (roll < params.movingChance)
+            return PlatformKind::Moving;
+        roll -= params.movingChance;
+        if (roll < params.oscillatingChance)
+            return PlatformKind::Oscillating;
+        roll -= params.oscillatingChance;
+        if (roll < params.crumblingChance)
+            return PlatformKind::Crumbling;
+        roll -= params.crumblingChance;
+        if (roll < params.springChance)
+            return PlatformKind::Spring;
+        return PlatformKind::Static;
+    }
+}
+
+void LevelGenerator::reset(Params const& params, uint64_t seed, float firstY) {
+    this->params = params;
+    random.reseed(seed, levelStream);
+    next = firstY;
+}
+
+std::size_t LevelGenerator::generate(float top, PlatformDesc* out, std::size_t capacity) {
+    if (next >= top)
+        return 0;
+    auto const pending = static_cast<std::size_t>(std::ceil((top - next) / params.spacing));
+    std::size_t const count = std::min(pending, capacity);
+
+    float const minX = -params.worldWidth / 2.f + params.platformWidth / 2.f;
+    float const maxX = params.worldWidth / 2.f - params.platformWidth / 2.f;
+    // one platform's rolls at a time, always in the same order, so where the calls split the layout
+    // doesn't change it.
+    for (std::size_t i = 0; i < count; ++i) {
+        float const x = random.nextFloat(minX, maxX);
+        uint32_t const variant = random.nextBelow(params.variants);
+        PlatformKind const kind = kindOf(params, random.nextBelow(100));
+        float const phase = random.nextFloat(0.f, 1.f);
+        out[i] = PlatformDesc{x, next, variant, kind, phase};
+        next += params.spacing;
+    }
+    return count;
+}
@@ -0,0 +1,66 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_LEVELGENERATOR_H
+#define DOODLE_LEVELGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../Core/Random.h"
+#include "Components.h"
+
+// one platform to spawn, position is the platform's center in world units.
+struct PlatformDesc {
+    float        x;
+    float        y;
+    uint32_t     variant;
+    PlatformKind kind  = PlatformKind::Static;
+    float        phase = 0.f;   // [0, 1), where a moving or oscillating platform starts its cycle
+};
+
+/*!
+ * Produces the platform layout of a run, bottom to top.
+ *
+ * The layout depends only on the run seed and the params: the generator draws from its own stream
+ * of that seed, so gameplay rolls never shift it, and each platform takes its rolls in the same
+ * order however generate() calls are split. That's what lets tools/levelcheck replay the levels of
+ * thousands of seeds without running the game, and checks they come out the same in chunks.
+ */
+class LevelGenerator {
+public:
+    struct Params {
+        float    worldWidth    = 1080.f;
+        float    platformWidth = 175.f;
+        float    spacing       = 150.f;   // vertical distance between consecutive platforms
+        uint32_t variants      = 5;       // textures a platform can pick from
+        // chance of each kind, out of 100. the rest are static.
+        uint32_t movingChance      = 10;
+        uint32_t oscillatingChance = 8;
+        uint32_t crumblingChance   = 8;
+        uint32_t springChance      = 4;
+    };
+
+    LevelGenerator() = default;
+
+    // restarts the layout, the first platform goes at firstY.
+    void reset(Params const& params, uint64_t seed, float firstY);
+
+    // writes the platforms below `top` that haven't been generated yet, at most `capacity` of them.
+    // returns how many were written, call again until it returns 0.
+    std::size_t generate(float top, PlatformDesc* out, std::size_t capacity);
+
+    float nextY() const { return next; }
+    Params const& getParams() const { return params; }
+
+private:
+    // stream the level draws from, anything but the gameplay one.
+    static constexpr uint64_t levelStream = 0x4c4556454cULL;
+
+    Params params{};
+    Random random;
+    float  next{0.f};
+};
+
+#endif //DOODLE_LEVELGENERATOR_H
@@ -0,0 +1,54 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "LevelStreamer.h"
+
+LevelStreamer::LevelStreamer(JobSystem& jobs) :
+        jobs { jobs }
+{
+}
+
+LevelStreamer::~LevelStreamer() {
+    jobs.wait(generating);
+}
+
+void LevelStreamer::restart(LevelGenerator::Params const& params, uint64_t seed, float firstY) {
+    // the job in flight belongs to the previous layout, let it finish and drop what it made.
+    jobs.wait(generating);
+    LevelChunk stale;
+    while (ready.pop(stale)) {}
+    generator.reset(params, seed, firstY);
+    started = true;
+    kick();
+}
+
+bool LevelStreamer::next(LevelChunk& chunk) {
+    bool const popped = ready.pop(chunk);
+    // there may be room again.
+    kick();
+    return popped;
+}
+
+void LevelStreamer::waitNext(LevelChunk& chunk) {
+    while (!next(chunk))
+        jobs.wait(generating);
+}
+
+void LevelStreamer::kick() {
+    if (started && generating.done() && ready.size() < ready.capacity())
+        jobs.run(&LevelStreamer::generate, this, generating);
+}
+
+void LevelStreamer::generate(void* context, std::size_t, std::size_t) {
+    auto& streamer = *static_cast<LevelStreamer*>(context);
+    LevelChunk chunk;
+    while (streamer.ready.size() < streamer.ready.capacity()) {
+        chunk.bottom = streamer.generator.nextY();
+        chunk.count = static_cast<uint32_t>(streamer.generator.generate(
+                chunk.bottom + chunkHeight, chunk.platforms, LevelChunk::maxPlatforms));
+        // when the spacing is too small for one chunk, the rest spills into the next one.
+        chunk.top = streamer.generator.nextY();
+        streamer.ready.push(chunk);
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_LEVELSTREAMER_H
+#define DOODLE_LEVELSTREAMER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LevelGenerator.h"
+#include "../Core/JobSystem.h"
+#include "../Core/SPSCQueue.h"
+
+// a horizontal slice of the level, every platform with bottom <= y < top.
+struct LevelChunk {
+    static constexpr std::size_t maxPlatforms = 32;
+
+    float        bottom;
+    float        top;
+    uint32_t     count;
+    PlatformDesc platforms[maxPlatforms];
+};
+
+/*!
+ * Runs the LevelGenerator as a job, a few fixed height chunks ahead of the game.
+ *
+ * A generation job fills a small SPSC queue and ends once it's full, the sim thread only ever pops
+ * a finished chunk and copies its descriptors out, and queues the next job when there's room again.
+ * At most one job is in flight, so the generator and the producing end of the queue only ever have
+ * one user at a time. Where the chunks split doesn't change the layout (see LevelGenerator), it's
+ * the same as generating inline, which tools/levelcheck checks for every seed it runs.
+ *
+ * Every call must come from the same (sim) thread, the owner of `jobs`.
+ */
+class LevelStreamer {
+public:
+    static constexpr float chunkHeight = 1200.f;
+
+    explicit LevelStreamer(JobSystem& jobs);
+    ~LevelStreamer();
+
+    LevelStreamer(LevelStreamer const&) = delete;
+    LevelStreamer& operator=(LevelStreamer const&) = delete;
+
+    // starts a new layout, chunks of the previous one still queued are dropped.
+    void restart(LevelGenerator::Params const& params, uint64_t seed, float firstY);
+
+    // the next chunk of the current run, false when the job hasn't produced it yet.
+    bool next(LevelChunk& chunk);
+
+    // the next chunk, running the job on this thread when no worker has picked it up yet.
+    void waitNext(LevelChunk& chunk);
+
+private:
+    static void generate(void* context, std::size_t, std::size_t);
+    // queues a generation job, unless one is in flight already or the queue is full.
+    void kick();
+
+    JobSystem& jobs;
+    JobCounter generating;
+    // the job's while one is in flight, the sim thread's otherwise.
+    LevelGenerator generator;
+    bool started{false};
+
+    // chunks kept ready ahead of the sim.
+    SPSCQueue<LevelChunk, 4> ready;
+};
+
+#endif //DOODLE_LEVELSTREAMER_H
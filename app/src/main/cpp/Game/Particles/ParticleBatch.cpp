@@ -0,0 +1,104 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "ParticleBatch.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define DOODLE_PARTICLE_NEON 1
+#elif defined(__AVX__)
+#   include <immintrin.h>
+#   define DOODLE_PARTICLE_AVX 1
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#   define DOODLE_PARTICLE_SSE 1
+#endif
+
+namespace {
+    // scalar loop over [begin, count), for the tail the vector loops leave behind.
+    void integrateTail(ParticleSoA const& particles, float deltaTime, std::size_t begin) {
+        for (std::size_t i = begin; i < particles.count; ++i) {
+            particles.velocityY[i] += particles.gravity[i] * deltaTime;
+            particles.x[i] += particles.velocityX[i] * deltaTime;
+            particles.y[i] += particles.velocityY[i] * deltaTime;
+            particles.life[i] -= deltaTime;
+        }
+    }
+}
+
+void ParticleBatch::Scalar::integrate(ParticleSoA const& particles, float deltaTime) {
+    integrateTail(particles, deltaTime, 0);
+}
+
+#if DOODLE_PARTICLE_NEON
+
+void ParticleBatch::integrate(ParticleSoA const& particles, float deltaTime) {
+    constexpr std::size_t lanes = 4;
+    std::size_t const vectorEnd = particles.count - particles.count % lanes;
+    float32x4_t const dt = vdupq_n_f32(deltaTime);
+    for (std::size_t i = 0; i < vectorEnd; i += lanes) {
+        float32x4_t const velocityY = vfmaq_f32(vld1q_f32(particles.velocityY + i), vld1q_f32(particles.gravity + i), dt);
+        vst1q_f32(particles.velocityY + i, velocityY);
+        vst1q_f32(particles.x + i, vfmaq_f32(vld1q_f32(particles.x + i), vld1q_f32(particles.velocityX + i), dt));
+        vst1q_f32(particles.y + i, vfmaq_f32(vld1q_f32(particles.y + i), velocityY, dt));
+        vst1q_f32(particles.life + i, vsubq_f32(vld1q_f32(particles.life + i), dt));
+    }
+    integrateTail(particles, deltaTime, vectorEnd);
+}
+
+#elif DOODLE_PARTICLE_AVX
+
+void ParticleBatch::integrate(ParticleSoA const& particles, float deltaTime) {
+    constexpr std::size_t lanes = 8;
+    std::size_t const vectorEnd = particles.count - particles.count % lanes;
+    __m256 const dt = _mm256_set1_ps(deltaTime);
+    for (std::size_t i = 0; i < vectorEnd; i += lanes) {
+        __m256 const velocityY = _mm256_add_ps(_mm256_loadu_ps(particles.velocityY + i),
+                                               _mm256_mul_ps(_mm256_loadu_ps(particles.gravity + i), dt));
+        _mm256_storeu_ps(particles.velocityY + i, velocityY);
+        _mm256_storeu_ps(particles.x + i, _mm256_add_ps(_mm256_loadu_ps(particles.x + i),
+                                                        _mm256_mul_ps(_mm256_loadu_ps(particles.velocityX + i), dt)));
+        _mm256_storeu_ps(particles.y + i, _mm256_add_ps(_mm256_loadu_ps(particles.y + i), _mm256_mul_ps(velocityY, dt)));
+        _mm256_storeu_ps(particles.life + i, _mm256_sub_ps(_mm256_loadu_ps(particles.life + i), dt));
+    }
+    integrateTail(particles, deltaTime, vectorEnd);
+}
+
+#elif DOODLE_PARTICLE_SSE
+
+void ParticleBatch::integrate(ParticleSoA const& particles, float deltaTime) {
+    constexpr std::size_t lanes = 4;
+    std::size_t const vectorEnd = particles.count - particles.count % lanes;
+    __m128 const dt = _mm_set1_ps(deltaTime);
+    for (std::size_t i = 0; i < vectorEnd; i += lanes) {
+        __m128 const velocityY = _mm_add_ps(_mm_loadu_ps(particles.velocityY + i),
+                                            _mm_mul_ps(_mm_loadu_ps(particles.gravity + i), dt));
+        _mm_storeu_ps(particles.velocityY + i, velocityY);
+        _mm_storeu_ps(particles.x + i, _mm_add_ps(_mm_loadu_ps(particles.x + i),
+                                                  _mm_mul_ps(_mm_loadu_ps(particles.velocityX + i), dt)));
+        _mm_storeu_ps(particles.y + i, _mm_add_ps(_mm_loadu_ps(particles.y + i), _mm_mul_ps(velocityY, dt)));
+        _mm_storeu_ps(particles.life + i, _mm_sub_ps(_mm_loadu_ps(particles.life + i), dt));
+    }
+    integrateTail(particles, deltaTime, vectorEnd);
+}
+
+#else
+
+void ParticleBatch::integrate(ParticleSoA const& particles, float deltaTime) {
+    Scalar::integrate(particles, deltaTime);
+}
+
+#endif
+
+const char* ParticleBatch::kernelName() {
+#if DOODLE_PARTICLE_NEON
+    return "neon";
+#elif DOODLE_PARTICLE_AVX
+    return "avx";
+#elif DOODLE_PARTICLE_SSE
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
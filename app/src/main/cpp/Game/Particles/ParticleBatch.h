@@ -0,0 +1,41 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_PARTICLEBATCH_H
+#define DOODLE_PARTICLEBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// the columns of a particle pool, `count` floats in each.
+struct ParticleSoA {
+    float*      x;
+    float*      y;
+    float*      velocityX;
+    float*      velocityY;
+    float*      gravity;      // per particle, units/s^2 added to velocityY
+    float*      life;         // seconds left, dead at <= 0
+    std::size_t count;
+};
+
+/*!
+ * Steps many particles at once, semi-implicit Euler like the player: velocity first, then position.
+ *
+ * Compiled for NEON on arm64, AVX (when the compiler targets it) or SSE2 on x86, and plain C++
+ * elsewhere, like AabbBatch. The Scalar namespace has the C++ version on every platform, for
+ * comparison.
+ */
+namespace ParticleBatch {
+    // advances every particle by deltaTime, dead ones included, they're dropped by the caller.
+    void integrate(ParticleSoA const& particles, float deltaTime);
+
+    // which implementation was compiled in, for logs and benchmarks.
+    const char* kernelName();
+}
+
+namespace ParticleBatch::Scalar {
+    void integrate(ParticleSoA const& particles, float deltaTime);
+}
+
+#endif //DOODLE_PARTICLEBATCH_H
@@ -0,0 +1,141 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // stream the bursts draw from, anything but the gameplay and level ones.
+    constexpr uint64_t particleStream = 0x5041525453ULL;
+
+    // burst parameters are rolled this many at a time.
+    constexpr std::size_t rollBatch = 16;
+}
+
+ParticleSoA ParticleSystem::Pool::columns() {
+    return ParticleSoA{x.data(), y.data(), velocityX.data(), velocityY.data(), gravity.data(), life.data(), count};
+}
+
+ParticleSystem::ParticleSystem(std::size_t poolCount, std::size_t poolCapacity) :
+        poolCapacity { poolCapacity },
+        poolsUsed { 0 },
+        pools ( poolCount ),
+        random { Random::defaultSeed, particleStream }
+{
+    for (Pool& pool : pools) {
+        pool.x.resize(poolCapacity);
+        pool.y.resize(poolCapacity);
+        pool.velocityX.resize(poolCapacity);
+        pool.velocityY.resize(poolCapacity);
+        pool.gravity.resize(poolCapacity);
+        pool.life.resize(poolCapacity);
+        pool.inverseLifetime.resize(poolCapacity);
+        pool.size.resize(poolCapacity);
+        pool.color.resize(poolCapacity);
+    }
+}
+
+EmitterId ParticleSystem::addEmitter(ParticleEmitter const& emitter) {
+    std::size_t pool = 0;
+    while (pool < poolsUsed && pools[pool].texture != emitter.texture)
+        ++pool;
+    if (pool == poolsUsed) {
+        if (poolsUsed == pools.size())
+            return invalidEmitter;
+        pools[poolsUsed++].texture = emitter.texture;
+    }
+    emitters.push_back(Binding{emitter, pool});
+    return static_cast<EmitterId>(emitters.size() - 1);
+}
+
+std::size_t ParticleSystem::emit(EmitterId id, glm::vec2 position, glm::vec2 velocity) {
+    if (id >= emitters.size())
+        return 0;
+    ParticleEmitter const& emitter = emitters[id].emitter;
+    Pool& pool = pools[emitters[id].pool];
+    std::size_t const count = std::min<std::size_t>(emitter.count, poolCapacity - pool.count);
+
+    float const minAngle = emitter.direction - emitter.spread / 2.f;
+    float const maxAngle = emitter.direction + emitter.spread / 2.f;
+    float angles[rollBatch];
+    float speeds[rollBatch];
+    float lives[rollBatch];
+    float sizes[rollBatch];
+    for (std::size_t done = 0; done < count;) {
+        std::size_t const batch = std::min(count - done, rollBatch);
+        random.fillFloats(angles, batch, minAngle, maxAngle);
+        random.fillFloats(speeds, batch, emitter.speedMin, emitter.speedMax);
+        random.fillFloats(lives, batch, emitter.lifeMin, emitter.lifeMax);
+        random.fillFloats(sizes, batch, emitter.sizeMin, emitter.sizeMax);
+        for (std::size_t i = 0; i < batch; ++i, ++done) {
+            std::size_t const slot = pool.count++;
+            pool.x[slot] = position.x;
+            pool.y[slot] = position.y;
+            pool.velocityX[slot] = velocity.x + std::cos(angles[i]) * speeds[i];
+            pool.velocityY[slot] = velocity.y + std::sin(angles[i]) * speeds[i];
+            pool.gravity[slot] = emitter.gravity;
+            pool.life[slot] = lives[i];
+            pool.inverseLifetime[slot] = 1.f / lives[i];
+            pool.size[slot] = sizes[i];
+            pool.color[slot] = emitter.color;
+        }
+    }
+    return count;
+}
+
+void ParticleSystem::update(float deltaTime) {
+    for (std::size_t i = 0; i < poolsUsed; ++i) {
+        Pool& pool = pools[i];
+        if (pool.count == 0)
+            continue;
+        ParticleBatch::integrate(pool.columns(), deltaTime);
+        compact(pool);
+    }
+}
+
+void ParticleSystem::compact(Pool& pool) {
+    // order doesn't matter, the last live particle fills each hole.
+    std::size_t count = pool.count;
+    for (std::size_t i = 0; i < count;) {
+        if (pool.life[i] > 0.f) {
+            ++i;
+            continue;
+        }
+        std::size_t const last = --count;
+        pool.x[i] = pool.x[last];
+        pool.y[i] = pool.y[last];
+        pool.velocityX[i] = pool.velocityX[last];
+        pool.velocityY[i] = pool.velocityY[last];
+        pool.gravity[i] = pool.gravity[last];
+        pool.life[i] = pool.life[last];
+        pool.inverseLifetime[i] = pool.inverseLifetime[last];
+        pool.size[i] = pool.size[last];
+        pool.color[i] = pool.color[last];
+    }
+    pool.count = count;
+}
+
+void ParticleSystem::clear() {
+    for (Pool& pool : pools)
+        pool.count = 0;
+}
+
+void ParticleSystem::reseed(uint64_t seed) {
+    random.reseed(seed, particleStream);
+}
+
+void ParticleSystem::pack(std::size_t index, ParticleInstance* out) const {
+    Pool const& pool = pools[index];
+    for (std::size_t i = 0; i < pool.count; ++i)
+        out[i] = ParticleInstance{pool.x[i], pool.y[i], pool.size[i], pool.life[i] * pool.inverseLifetime[i], pool.color[i]};
+}
+
+std::size_t ParticleSystem::getLiveParticles() const {
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < poolsUsed; ++i)
+        live += pools[i].count;
+    return live;
+}
@@ -0,0 +1,112 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_PARTICLESYSTEM_H
+#define DOODLE_PARTICLESYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/vec2.hpp>
+
+#include "ParticleBatch.h"
+#include "../Components.h"
+#include "../../Core/Random.h"
+
+// what one burst looks like. angles are in radians, 0 along +x, counter clockwise.
+struct ParticleEmitter {
+    GLuint   texture   = NO_TEXTURE;
+    uint32_t count     = 8;
+    float    direction = 1.5707964f;   // straight up
+    float    spread    = 6.2831855f;   // full circle
+    float    speedMin  = 100.f;
+    float    speedMax  = 300.f;
+    float    lifeMin   = 0.3f;
+    float    lifeMax   = 0.6f;
+    float    sizeMin   = 8.f;
+    float    sizeMax   = 16.f;
+    float    gravity   = -1000.f;
+    uint32_t color     = 0xFFFFFFFF;   // RGBA8, red in the low byte
+};
+
+using EmitterId = uint32_t;
+constexpr EmitterId invalidEmitter = UINT32_MAX;
+
+// one particle as the renderer draws it, an instanced vertex.
+struct ParticleInstance {
+    float    x;
+    float    y;
+    float    size;
+    float    fade;    // 1 at birth down to 0 at death, multiplies the color's alpha
+    uint32_t color;
+};
+
+/*!
+ * Particles in fixed capacity pools, one pool per texture, so a frame's particles are one instanced
+ * draw per texture.
+ *
+ * Every pool is allocated up front as structure of arrays and its live particles are kept dense at
+ * the front: a burst is appended (and cut short when the pool is full), a step integrates the whole
+ * pool with ParticleBatch and then swaps every dead particle with the last live one. Emitters are
+ * registered once and bound to their texture's pool then, emitting only writes into the columns,
+ * so nothing allocates after construction.
+ *
+ * Bursts roll from their own generator, so effects never shift gameplay randomness.
+ */
+class ParticleSystem {
+public:
+    ParticleSystem(std::size_t poolCount, std::size_t poolCapacity);
+
+    // registers an effect, invalidEmitter when every pool is taken by other textures already.
+    EmitterId addEmitter(ParticleEmitter const& emitter);
+    // a burst at `position`, every particle also inherits `velocity`. returns how many fit.
+    std::size_t emit(EmitterId emitter, glm::vec2 position, glm::vec2 velocity = glm::vec2{0.f});
+
+    void update(float deltaTime);
+    // drops every particle, emitters stay registered.
+    void clear();
+    void reseed(uint64_t seed);
+
+    // ---- rendering ----
+    // pools in use, a pool's index never changes.
+    std::size_t getPoolCount() const { return poolsUsed; }
+    GLuint getPoolTexture(std::size_t pool) const { return pools[pool].texture; }
+    std::size_t getPoolSize(std::size_t pool) const { return pools[pool].count; }
+    std::size_t getPoolCapacity() const { return poolCapacity; }
+    // writes the pool's live particles to out, getPoolSize(pool) of them.
+    void pack(std::size_t pool, ParticleInstance* out) const;
+
+    std::size_t getLiveParticles() const;
+
+private:
+    struct Pool {
+        GLuint texture = NO_TEXTURE;
+        std::size_t count = 0;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> gravity;
+        std::vector<float> life;
+        std::vector<float> inverseLifetime;
+        std::vector<float> size;
+        std::vector<uint32_t> color;
+
+        ParticleSoA columns();
+    };
+    struct Binding {
+        ParticleEmitter emitter;
+        std::size_t pool;
+    };
+
+    static void compact(Pool& pool);
+
+    std::size_t poolCapacity;
+    std::size_t poolsUsed;
+    std::vector<Pool> pools;
+    std::vector<Binding> emitters;
+    Random random;
+};
+
+#endif //DOODLE_PARTICLESYSTEM_H
@@ -0,0 +1,121 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "PlatformBehaviours.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/common.hpp>
+
+#include "Collision/Broadphase.h"
+#include "Collision/Collision.h"
+
+namespace {
+    constexpr float twoPi = 6.28318530718f;
+}
+
+PlatformBehaviours::PlatformBehaviours(Params const& params) :
+        params { params }
+{}
+
+void PlatformBehaviours::add(CommandBuffer& commands, Entity platform, PlatformKind kind, Transform& transform,
+                             float phase, float halfWidth) const {
+    switch (kind) {
+        case PlatformKind::Moving: {
+            // back and forth over its travel, phase 0 at the left end heading right.
+            float const minX = std::max(transform.position.x - params.moveRange, -halfWidth + transform.scale.x / 2.f);
+            float const maxX = std::max(minX, std::min(transform.position.x + params.moveRange, halfWidth - transform.scale.x / 2.f));
+            float const along = 2.f * phase;
+            transform.position.x = along < 1.f ? minX + along * (maxX - minX) : maxX - (along - 1.f) * (maxX - minX);
+            commands.add(platform, MovingPath{minX, maxX, along < 1.f ? params.moveSpeed : -params.moveSpeed});
+            break;
+        }
+        case PlatformKind::Oscillating: {
+            float const anchorY = transform.position.y;
+            float const angle = phase * twoPi;
+            transform.position.y = anchorY + params.oscillateRange * std::sin(angle);
+            commands.add(platform, Oscillation{anchorY, angle});
+            break;
+        }
+        default:
+            // static, springs and intact crumbling platforms have nothing to update.
+            break;
+    }
+}
+
+void PlatformBehaviours::update(World& world, float deltaTime, Broadphase& broadphase, CommandBuffer& commands) const {
+    updateMoving(world, deltaTime, broadphase);
+    updateOscillating(world, deltaTime, broadphase);
+    updateCrumbling(world, deltaTime, commands);
+}
+
+void PlatformBehaviours::updateMoving(World& world, float deltaTime, Broadphase& broadphase) const {
+    // bounce off the ends of the travel, the overshoot is folded back.
+    world.forEach<Transform, PlatformInfo, MovingPath, Collider const>(
+            [&](Entity, Transform& transform, PlatformInfo& info, MovingPath& path, Collider const& collider) {
+        float const moved = transform.position.x + path.velocity * deltaTime;
+        float const overMax = moved - path.maxX;
+        float const underMin = path.minX - moved;
+        float const x = overMax > 0.f ? path.maxX - overMax : underMin > 0.f ? path.minX + underMin : moved;
+        path.velocity = overMax > 0.f ? -std::fabs(path.velocity) : underMin > 0.f ? std::fabs(path.velocity) : path.velocity;
+        apply(transform, info, collider, glm::vec2{x - transform.position.x, 0.f}, broadphase);
+    });
+}
+
+void PlatformBehaviours::updateOscillating(World& world, float deltaTime, Broadphase& broadphase) const {
+    float const step = twoPi / params.oscillatePeriod * deltaTime;
+    world.forEach<Transform, PlatformInfo, Oscillation, Collider const>(
+            [&](Entity, Transform& transform, PlatformInfo& info, Oscillation& oscillation, Collider const& collider) {
+        float const angle = oscillation.phase + step;
+        oscillation.phase = angle >= twoPi ? angle - twoPi : angle;
+        float const y = oscillation.anchorY + params.oscillateRange * std::sin(oscillation.phase);
+        apply(transform, info, collider, glm::vec2{0.f, y - transform.position.y}, broadphase);
+    });
+}
+
+void PlatformBehaviours::updateCrumbling(World& world, float deltaTime, CommandBuffer& commands) const {
+    // out of the broadphase already, they only fall and fade.
+    world.forEach<Transform, Sprite, Crumble>([&](Entity platform, Transform& transform, Sprite& sprite, Crumble& crumble) {
+        crumble.velocity -= params.crumbleGravity * deltaTime;
+        crumble.timeLeft -= deltaTime;
+        transform.position.y += crumble.velocity * deltaTime;
+        sprite.colorMultiplier.a = std::max(0.f, crumble.timeLeft / params.crumbleTime);
+        // gone, it stays invisible where it is until it's culled.
+        if (crumble.timeLeft <= 0.f)
+            commands.remove<Crumble>(platform);
+    });
+}
+
+float PlatformBehaviours::land(World& world, Entity platform, Broadphase& broadphase, CommandBuffer& commands) const {
+    PlatformInfo const* info = world.get<PlatformInfo>(platform);
+    if (!info)
+        return 1.f;
+    switch (info->kind) {
+        case PlatformKind::Spring:
+            return params.springBoost;
+        case PlatformKind::Crumbling: {
+            Collider* collider = world.get<Collider>(platform);
+            if (!collider || collider->proxy == invalidProxy)
+                return 1.f;
+            // nothing lands on it again. the proxy is marked gone right away, the component only
+            // goes at the end of the frame.
+            broadphase.remove(collider->proxy);
+            collider->proxy = invalidProxy;
+            commands.remove<Collider>(platform);
+            commands.add(platform, Crumble{0.f, params.crumbleTime});
+            return 1.f;
+        }
+        default:
+            return 1.f;
+    }
+}
+
+void PlatformBehaviours::apply(Transform& transform, PlatformInfo& info, Collider const& collider, glm::vec2 displacement,
+                               Broadphase& broadphase) {
+    AABB const before = AABB::fromCenter(transform.position, transform.scale);
+    transform.position += displacement;
+    info.displacement = displacement;
+    AABB const after = AABB::fromCenter(transform.position, transform.scale);
+    broadphase.update(collider.proxy, AABB{glm::min(before.min, after.min), glm::max(before.max, after.max)});
+}
@@ -0,0 +1,68 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_PLATFORMBEHAVIOURS_H
+#define DOODLE_PLATFORMBEHAVIOURS_H
+
+#include <glm/vec2.hpp>
+
+#include "Components.h"
+#include "Ecs/CommandBuffer.h"
+#include "Ecs/World.h"
+
+class Broadphase;
+
+/*!
+ * The systems that move the platforms that aren't static, one kind at a time.
+ *
+ * A kind with per step work has its own component (MovingPath, Oscillation, Crumble), so each
+ * system is one query over exactly the platforms of its kind, streaming through their chunks. The
+ * results are written to the platforms' Transform and PlatformInfo::displacement and to their
+ * broadphase boxes, so collision and culling see the moved platforms like any other.
+ *
+ * Spring platforms have no component, they only matter when landed on. A crumbling platform gets
+ * a Crumble and loses its Collider once it's bounced on, and falls out of the level.
+ *
+ * Components are added and removed through the frame's CommandBuffer, these run mid query.
+ */
+class PlatformBehaviours {
+public:
+    struct Params {
+        float moveSpeed        = 180.f;   // units/s, moving platforms
+        float moveRange        = 240.f;   // half of a moving platform's travel
+        float oscillateRange   = 60.f;    // keep below half the platform spacing, so they don't cross
+        float oscillatePeriod  = 2.5f;    // seconds
+        float crumbleTime      = 0.6f;    // seconds a crumbled platform takes to fade out
+        float crumbleGravity   = 2000.f;
+        float springBoost      = 1.6f;    // times the regular jump velocity
+    };
+
+    PlatformBehaviours() = default;
+    explicit PlatformBehaviours(Params const& params);
+
+    // queues the behaviour of a platform being spawned, `phase` in [0, 1) is where in its cycle it
+    // starts and `transform` is moved there. moving platforms stay within [-halfWidth, halfWidth].
+    void add(CommandBuffer& commands, Entity platform, PlatformKind kind, Transform& transform,
+             float phase, float halfWidth) const;
+
+    // runs every kind's system for deltaTime and moves the platforms' broadphase boxes along.
+    void update(World& world, float deltaTime, Broadphase& broadphase, CommandBuffer& commands) const;
+
+    // the player bounced off `platform`. returns the jump velocity multiplier for the bounce.
+    float land(World& world, Entity platform, Broadphase& broadphase, CommandBuffer& commands) const;
+
+    Params const& getParams() const { return params; }
+
+private:
+    void updateMoving(World& world, float deltaTime, Broadphase& broadphase) const;
+    void updateOscillating(World& world, float deltaTime, Broadphase& broadphase) const;
+    void updateCrumbling(World& world, float deltaTime, CommandBuffer& commands) const;
+    // moves the platform by its displacement, its box covers the whole step.
+    static void apply(Transform& transform, PlatformInfo& info, Collider const& collider, glm::vec2 displacement,
+                      Broadphase& broadphase);
+
+    Params params{};
+};
+
+#endif //DOODLE_PLATFORMBEHAVIOURS_H
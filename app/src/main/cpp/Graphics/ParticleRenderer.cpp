@@ -0,0 +1,97 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "ParticleRenderer.h"
+
+#include <cassert>
+#include <cstddef>
+
+#include "../Game/Particles/ParticleSystem.h"
+
+namespace {
+    // attribute locations, fixed in particle.vert.
+    constexpr GLuint instanceAttribute = 0;
+    constexpr GLuint colorAttribute = 1;
+}
+
+ParticleRenderer::~ParticleRenderer() {
+    if (!vertexArrays.empty())
+        glDeleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+    if (!instanceBuffers.empty())
+        glDeleteBuffers(static_cast<GLsizei>(instanceBuffers.size()), instanceBuffers.data());
+}
+
+bool ParticleRenderer::init(AAssetManager* assetManager) {
+    assert(vertexArrays.empty() && "init() once per context");
+    shader = std::unique_ptr<Shader>(Shader::loadShader("particle.vert", "particle.frag", assetManager));
+    return shader != nullptr;
+}
+
+void ParticleRenderer::abandon() {
+    if (shader)
+        shader->abandon();
+    shader.reset();
+    // the pools are recreated on the next render.
+    vertexArrays.clear();
+    instanceBuffers.clear();
+}
+
+void ParticleRenderer::ensurePools(ParticleSystem const& particles) {
+    std::size_t const first = vertexArrays.size();
+    std::size_t const count = particles.getPoolCount();
+    if (count <= first)
+        return;
+    bufferSize = static_cast<GLsizeiptr>(particles.getPoolCapacity() * sizeof(ParticleInstance));
+    vertexArrays.resize(count);
+    instanceBuffers.resize(count);
+    glGenVertexArrays(static_cast<GLsizei>(count - first), vertexArrays.data() + first);
+    glGenBuffers(static_cast<GLsizei>(count - first), instanceBuffers.data() + first);
+    for (std::size_t i = first; i < count; ++i) {
+        glBindVertexArray(vertexArrays[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+        // x, y, size, fade
+        glEnableVertexAttribArray(instanceAttribute);
+        glVertexAttribPointer(instanceAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance),
+                              reinterpret_cast<const void*>(offsetof(ParticleInstance, x)));
+        glVertexAttribDivisor(instanceAttribute, 1);
+        glEnableVertexAttribArray(colorAttribute);
+        glVertexAttribPointer(colorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ParticleInstance),
+                              reinterpret_cast<const void*>(offsetof(ParticleInstance, color)));
+        glVertexAttribDivisor(colorAttribute, 1);
+    }
+    glBindVertexArray(0);
+}
+
+void ParticleRenderer::render(ParticleSystem const& particles, glm::mat4 const& viewProjection,
+                              std::vector<GLuint> const& textureNames, GLuint fallbackTexture) {
+    if (!shader || particles.getLiveParticles() == 0)
+        return;
+    ensurePools(particles);
+
+    shader->activate();
+    shader->setMatrix("viewProjection", viewProjection);
+    shader->setImageUniform("uTexture", 0);
+    glActiveTexture(GL_TEXTURE0);
+    for (std::size_t i = 0; i < particles.getPoolCount(); ++i) {
+        std::size_t const count = particles.getPoolSize(i);
+        if (count == 0)
+            continue;
+        glBindVertexArray(vertexArrays[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffers[i]);
+        // orphaned, so the driver never waits on the draw still reading last frame's instances.
+        auto* instances = static_cast<ParticleInstance*>(glMapBufferRange(
+                GL_ARRAY_BUFFER, 0, bufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (!instances)
+            continue;
+        particles.pack(i, instances);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+
+        GLuint const texture = particles.getPoolTexture(i);
+        bool const named = texture < textureNames.size() && textureNames[texture] != 0;
+        glBindTexture(GL_TEXTURE_2D, named ? textureNames[texture] : fallbackTexture);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(count));
+    }
+    glBindVertexArray(0);
+}
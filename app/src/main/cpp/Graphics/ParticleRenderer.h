@@ -0,0 +1,53 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_PARTICLERENDERER_H
+#define DOODLE_PARTICLERENDERER_H
+
+#include <memory>
+#include <vector>
+#include <GLES3/gl3.h>
+#include <glm/mat4x4.hpp>
+
+#include "Shader.h"
+
+class AAssetManager;
+class ParticleSystem;
+
+/*!
+ * Draws a ParticleSystem with one instanced draw per pool, so per texture.
+ *
+ * Each pool has its own vertex array and a streamed instance buffer sized for the whole pool.
+ * Every frame the buffer is orphaned and the live particles are packed straight into the mapped
+ * storage, the quad itself comes from gl_VertexID like the main shader.
+ */
+class ParticleRenderer {
+public:
+    ParticleRenderer() = default;
+    ~ParticleRenderer();
+
+    ParticleRenderer(ParticleRenderer const&) = delete;
+    ParticleRenderer& operator=(ParticleRenderer const&) = delete;
+
+    // needs a current context. false when the shader didn't load.
+    bool init(AAssetManager* assetManager);
+    // the context went with every GL object in it, forgets them. init() again in the next one.
+    void abandon();
+
+    // pool textures are ids into `textureNames`, `fallbackTexture` is bound for pools without one
+    // and for textures that failed to load (name 0).
+    void render(ParticleSystem const& particles, glm::mat4 const& viewProjection,
+                std::vector<GLuint> const& textureNames, GLuint fallbackTexture);
+
+private:
+    // creates the vertex arrays and buffers of any pool seen for the first time in this context.
+    void ensurePools(ParticleSystem const& particles);
+
+    std::unique_ptr<Shader> shader;
+    std::vector<GLuint> vertexArrays;
+    std::vector<GLuint> instanceBuffers;
+    GLsizeiptr bufferSize = 0;
+};
+
+#endif //DOODLE_PARTICLERENDERER_H
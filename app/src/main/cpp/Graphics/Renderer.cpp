@@ -3,12 +3,15 @@
 //
 
 #include "Renderer.h"
-#include "../Game/GameObject/GameObject.h"
+#include "../Game/Components.h"
 #include "../AndroidUtils/AndroidOut.h"
+#include "../Core/StartupTrace.h"
 #include "../Engine.h"
 
 #include <game-activity/native_app_glue/android_native_app_glue.h>
 #include <GLES3/gl3.h>
+#include <algorithm>
+#include <cctype>
 #include <memory>
 #include <vector>
 #include <android/imagedecoder.h>
@@ -17,6 +20,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 void Renderer::initRenderer() {
+    StartupTrace::Scope stage{startupTrace(), "renderer"};
+    // the decodes run while the display comes up, and everything after it.
+    preloadTextures();
+
     // Choose your render attributes
     constexpr EGLint attribs[] = {
             EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
@@ -63,35 +70,75 @@ void Renderer::initRenderer() {
     aout << "Found " << numConfigs << " configs" << std::endl;
     aout << "Chose " << config << std::endl;
 
-    // create the proper window surface
-    EGLint format;
-    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &format);
-    EGLSurface surface = eglCreateWindowSurface(display, config, app_->window, nullptr);
+    display_ = display;
+    config_ = config;
 
-    // Create a GLES 3 context
-    EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
-    EGLContext context = eglCreateContext(display, config, nullptr, contextAttribs);
+    // initialise camera..
+    camera.position = {0, 0};
 
-    // get some window metrics
-    auto madeCurrent = eglMakeCurrent(display, surface, surface, context);
-    assert(madeCurrent);
+    // initialise none texture..
+    auto assetManager = app_->activity->assetManager;
+    noneTexture = TextureAsset::loadAsset(assetManager, "None.png");
+}
 
-    display_ = display;
-    surface_ = surface;
-    context_ = context;
+bool Renderer::attachWindow() {
+    assert(!hasWindow());
+    // create the proper window surface
+    surface_ = eglCreateWindowSurface(display_, config_, app_->window, nullptr);
+    assert(surface_ != EGL_NO_SURFACE);
+
+    bool rebuilt = false;
+    // the context of the last window, with every GL object in it, unless it was lost in between.
+    if (context_ != EGL_NO_CONTEXT && eglMakeCurrent(display_, surface_, surface_, context_) != EGL_TRUE) {
+        aout << "Kept context is gone (" << std::hex << eglGetError() << std::dec << "), rebuilding" << std::endl;
+        loseContext();
+    }
+    if (context_ == EGL_NO_CONTEXT) {
+        createContext();
+        rebuilt = true;
+    }
 
     // make width and height invalid so it gets updated the first frame in @a updateRenderArea()
     width_ = -1;
     height_ = -1;
+    updateRenderArea();
+    return rebuilt;
+}
+
+void Renderer::detachWindow() {
+    if (!hasWindow())
+        return;
+    // the context stays, current nowhere, until the next window.
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(display_, surface_);
+    surface_ = EGL_NO_SURFACE;
+}
+
+void Renderer::createContext() {
+    {
+        StartupTrace::Scope stage{startupTrace(), "context"};
+        // Create a GLES 3 context
+        EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+        context_ = eglCreateContext(display_, config_, nullptr, contextAttribs);
+
+        // get some window metrics
+        auto madeCurrent = eglMakeCurrent(display_, surface_, surface_, context_);
+        assert(madeCurrent);
+    }
 
     PRINT_GL_STRING(GL_VENDOR);
     PRINT_GL_STRING(GL_RENDERER);
     PRINT_GL_STRING(GL_VERSION);
-    PRINT_GL_STRING_AS_LIST(GL_EXTENSIONS);
 
-    mainShader = std::unique_ptr<Shader>(
-            Shader::loadShader("main.vert", "main.frag", app_->activity->assetManager));
-    assert(mainShader);
+    {
+        // the preload decodes keep going on the jobs meanwhile.
+        StartupTrace::Scope stage{startupTrace(), "shaders"};
+        mainShader = std::unique_ptr<Shader>(
+                Shader::loadShader("main.vert", "main.frag", app_->activity->assetManager));
+        assert(mainShader);
+        if (!particleRenderer.init(app_->activity->assetManager))
+            aout << "Failed to load the particle shader, effects are off" << std::endl;
+    }
 
     // Note: there's only one shader in this demo, so I'll activate it here. For a more complex game
     // you'll want to track the active shader and activate/deactivate it as necessary
@@ -104,13 +151,92 @@ void Renderer::initRenderer() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // initialise camera..
-    camera.position = {0, 0};
-    updateRenderArea();
+    // every texture so far, from the decoded copies. the ids stay what the game was given.
+    finishPreload();
+    StartupTrace::Scope stage{startupTrace(), "upload"};
+    noneTexture->upload();
+    for (std::size_t i = 0; i < textures.size(); ++i) {
+        if (!textures[i])
+            continue;
+        textures[i]->upload();
+        textureNames[i] = textures[i]->getTextureID();
+    }
+}
 
-    // initialise none texture..
-    auto assetManager = app_->activity->assetManager;
-    noneTexture = TextureAsset::loadAsset(assetManager, "None.png");
+void Renderer::preloadTextures() {
+    AAsset* manifest = AAssetManager_open(app_->activity->assetManager, "preload.txt", AASSET_MODE_BUFFER);
+    if (!manifest) {
+        aout << "No preload manifest, textures are decoded when first asked for" << std::endl;
+        return;
+    }
+    auto const* text = static_cast<char const*>(AAsset_getBuffer(manifest));
+    auto const length = text ? static_cast<std::size_t>(AAsset_getLength(manifest)) : 0;
+    // one path per line, '#' starts a comment line.
+    for (std::size_t begin = 0; begin < length;) {
+        std::size_t end = begin;
+        while (end < length && text[end] != '\n')
+            ++end;
+        std::string path(text + begin, text + end);
+        while (!path.empty() && std::isspace(static_cast<unsigned char>(path.back())))
+            path.pop_back();
+        if (!path.empty() && path[0] != '#' && textureFilepathToId.count(path) == 0) {
+            textureFilepathToId[path] = static_cast<GLuint>(preloadPaths.size());
+            preloadPaths.push_back(std::move(path));
+        }
+        begin = end + 1;
+    }
+    AAsset_close(manifest);
+
+    // the slots are there before any decode writes one, and nothing else touches them until
+    // finishPreload().
+    textures.resize(preloadPaths.size());
+    textureNames.assign(preloadPaths.size(), 0);
+    preloading = true;
+    // one job each, the background alone is most of the work.
+    for (std::size_t i = 0; i < preloadPaths.size(); ++i)
+        engine.jobs.run(&Renderer::decodeJob, this, preloadJobs, i, i + 1);
+}
+
+void Renderer::decodeJob(void* context, std::size_t begin, std::size_t end) {
+    auto& renderer = *static_cast<Renderer*>(context);
+    for (std::size_t i = begin; i < end; ++i) {
+        StartupTrace::Scope stage{startupTrace(), "decode", renderer.preloadPaths[i].c_str()};
+        renderer.textures[i] = TextureAsset::loadAsset(renderer.app_->activity->assetManager, renderer.preloadPaths[i]);
+    }
+}
+
+void Renderer::finishPreload() {
+    if (!preloading)
+        return;
+    {
+        StartupTrace::Scope stage{startupTrace(), "preload wait"};
+        engine.jobs.wait(preloadJobs);
+    }
+    preloading = false;
+    for (std::size_t i = 0; i < preloadPaths.size(); ++i) {
+        if (textures[i])
+            LOGI("Texture Loaded %u, for file path %s", static_cast<GLuint>(i), preloadPaths[i].c_str());
+        else
+            LOGE("Failed to load texture: %s", preloadPaths[i].c_str());
+    }
+}
+
+void Renderer::loseContext() {
+    if (context_ == EGL_NO_CONTEXT)
+        return;
+    // nothing here is deleted, it went with the context.
+    mainShader->abandon();
+    mainShader.reset();
+    particleRenderer.abandon();
+    noneTexture->abandon();
+    for (std::size_t i = 0; i < textures.size(); ++i) {
+        if (textures[i])
+            textures[i]->abandon();
+        textureNames[i] = 0;
+    }
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display_, context_);
+    context_ = EGL_NO_CONTEXT;
 }
 
 void Renderer::updateRenderArea() {
@@ -135,32 +261,80 @@ void Renderer::render() {
     updateRenderArea();
 
     // get camera's projection matrix.. (camera will always be moving, no point lazy calculating it..)
-    mainShader->setMatrix("viewProjection", camera.getViewProjection()) ;
+    glm::mat4 const viewProjection = camera.getViewProjection();
+    mainShader->activate();
+    mainShader->setMatrix("viewProjection", viewProjection);
     mainShader->setImageUniform("uTexture", 0);
 
+    // everything the draws need is worked out up front, the GL calls below only read it.
+    extractDrawItems();
+
     // clear the color buffer
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Render all game objects.
-    renderLayer(static_cast<int>(GameObjectType::Environment));
-    renderLayer(static_cast<int>(GameObjectType::Platform));
-    renderLayer(static_cast<int>(GameObjectType::Player));
+    // Render all sprites.
+    renderLayer(static_cast<int>(EntityType::Environment));
+    renderLayer(static_cast<int>(EntityType::Platform));
+    // effects go between the platforms and the player, one instanced draw per texture.
+    particleRenderer.render(engine.game.getParticles(), viewProjection, textureNames, noneTexture->getTextureID());
+    mainShader->activate();
+    renderLayer(static_cast<int>(EntityType::Player));
 
     // Present the rendered image. This is an implicit glFlush.
-    auto swapResult = eglSwapBuffers(display_, surface_);
-    assert(swapResult == EGL_TRUE);
+    if (eglSwapBuffers(display_, surface_) != EGL_TRUE) {
+        EGLint const error = eglGetError();
+        // the frame is lost with the context, the next one draws into a rebuilt one.
+        assert(error == EGL_CONTEXT_LOST);
+        aout << "Context lost while drawing, rebuilding" << std::endl;
+        loseContext();
+        createContext();
+    }
 }
 
-glm::mat4 Renderer::calculateModelMatrix(GameObject const& gameObject) {
+glm::mat4 Renderer::calculateModelMatrix(Transform const& transform) {
     glm::mat4 modelMatrix { 1.f };
 
-    modelMatrix = glm::translate(modelMatrix, glm::vec3{ gameObject.position, 0.f });
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(gameObject.rotation), {0.0f, 0.0f, 1.0f});     // Because this is 2D, we rotate in the Z-axis.
-    modelMatrix = glm::scale(modelMatrix, glm::vec3{ gameObject.scale, 1.f });
+    modelMatrix = glm::translate(modelMatrix, glm::vec3{ transform.position, 0.f });
+    modelMatrix = glm::rotate(modelMatrix, glm::radians(transform.rotation), {0.0f, 0.0f, 1.0f});     // Because this is 2D, we rotate in the Z-axis.
+    modelMatrix = glm::scale(modelMatrix, glm::vec3{ transform.scale, 1.f });
 
     return modelMatrix;
 }
 
+void Renderer::extractDrawItems() {
+    // entities per job, matrices are cheap so only a big scene is worth splitting.
+    constexpr std::size_t extractGrain = 256;
+
+    // the chunks go into a flat list first, so the jobs can split on entities rather than chunks.
+    using DrawQuery = ChunkView<Transform const, Sprite const>;
+    drawChunks.clear();
+    std::size_t count = 0;
+    engine.game.getWorld().forEachChunk<Transform const, Sprite const>([&](DrawQuery& chunk) {
+        drawChunks.push_back(DrawChunk{chunk.column<Transform>(), chunk.column<Sprite>(), count});
+        count += chunk.count;
+    });
+    drawItems.resize(count);
+    GLuint const fallbackTexture = noneTexture->getTextureID();
+    engine.jobs.parallelFor(0, count, extractGrain, [&](std::size_t begin, std::size_t end) {
+        // the last chunk starting at or before `begin`.
+        auto chunk = std::upper_bound(drawChunks.begin(), drawChunks.end(), begin,
+                [](std::size_t item, DrawChunk const& next) { return item < next.first; }) - 1;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (chunk + 1 != drawChunks.end() && (chunk + 1)->first == i)
+                ++chunk;
+            std::size_t const row = i - chunk->first;
+            Sprite const& sprite = chunk->sprites[row];
+            drawItems[i] = DrawItem{
+                    calculateModelMatrix(chunk->transforms[row]),
+                    sprite.colorMultiplier,
+                    sprite.textureId < textureNames.size() && textureNames[sprite.textureId] != 0
+                            ? textureNames[sprite.textureId] : fallbackTexture,
+                    static_cast<int>(sprite.layer)
+            };
+        }
+    });
+}
+
 GLuint Renderer::getTextureId(std::string const& filepath) {
     // First we check if this texture is already loaded..
     auto iterator = textureFilepathToId.find(filepath);
@@ -170,31 +344,36 @@ GLuint Renderer::getTextureId(std::string const& filepath) {
         return iterator->second;
     }
 
-    // Not loaded, let's attempt to load it.
+    // Not loaded, let's attempt to load it. the preload slots have to stay put while decodes fill them.
+    finishPreload();
+    LOGW("%s isn't in the preload manifest, decoding it now", filepath.c_str());
     auto assetManager = app_->activity->assetManager;
     std::shared_ptr<TextureAsset> texture = TextureAsset::loadAsset(assetManager, filepath);
 
     // loading successful..
     if(texture) {
-        GLuint textureId = texture->getTextureID();
+        auto textureId = static_cast<GLuint>(textures.size());
+        // without a context it's only decoded, createContext() uploads it.
+        if (context_ != EGL_NO_CONTEXT)
+            texture->upload();
+        textureNames.push_back(texture->getTextureID());
         textures.push_back(std::move(texture)); // move ownership to from local variable to renderer
-        LOGI("Texture Loaded %d, for file path %s", textureId, filepath.c_str());
+        LOGI("Texture Loaded %u, for file path %s", textureId, filepath.c_str());
         textureFilepathToId[filepath] = textureId;
         return textureId;
     }
     else {
-        aout << "Failed to load texture: " << filepath << std::endl;
         LOGE("Failed to load texture: %s", filepath.c_str());
         return NO_TEXTURE;
     }
 }
 Renderer::~Renderer() {
+    // no decode may outlive the renderer, or the jobs.
+    finishPreload();
     if (display_ != EGL_NO_DISPLAY) {
-        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-        if (context_ != EGL_NO_CONTEXT) {
-            eglDestroyContext(display_, context_);
-            context_ = EGL_NO_CONTEXT;
-        }
+        // destroying the context frees every GL object in it, there may be no surface to make it
+        // current on to delete them one by one.
+        loseContext();
         if (surface_ != EGL_NO_SURFACE) {
             eglDestroySurface(display_, surface_);
             surface_ = EGL_NO_SURFACE;
@@ -205,16 +384,15 @@ Renderer::~Renderer() {
 }
 
 void Renderer::renderLayer(int type) {
-    for(auto& gameObjectPtr : engine.game.getGameObjects()) {
-        GameObject& gameObject = *gameObjectPtr;
-        if(static_cast<int>(gameObject.getType()) != type)
+    for(DrawItem const& item : drawItems) {
+        if(item.type != type)
             continue;
         // Setup the texture
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, gameObject.textureId != NO_TEXTURE ? gameObject.textureId : noneTexture->getTextureID());
+        glBindTexture(GL_TEXTURE_2D, item.textureId);
 
-        mainShader->setMatrix("model", calculateModelMatrix(gameObject));
-        mainShader->setVec4("colorMultiplier", gameObject.colorMultiplier);
+        mainShader->setMatrix("model", item.model);
+        mainShader->setVec4("colorMultiplier", item.colorMultiplier);
 
         // VBO-less draw.
         glDrawArrays(GL_TRIANGLES, 0, 6);
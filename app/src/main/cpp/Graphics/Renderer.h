@@ -14,18 +14,40 @@ struct android_app;
 #include "Shader.h"
 #include "config.h"
 #include "Camera.h"
+#include "ParticleRenderer.h"
+#include "../Core/JobSystem.h"
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 class Engine;
-class GameObject;
+struct Transform;
+struct Sprite;
+
+/*!
+ * Draws the game into the app's window.
+ *
+ * What outlives a window is kept apart from what doesn't: the camera and every decoded texture
+ * belong to the renderer, the surface belongs to the window and the context holds the GL objects
+ * made from them. Losing the window only costs the surface, the context is kept for the next one.
+ * When the context is lost as well, its objects are rebuilt from the decoded textures.
+ *
+ * Texture ids handed out by getTextureId() are the renderer's own and survive all of that, they're
+ * resolved to GL names when drawing.
+ *
+ * The textures listed in assets/preload.txt are decoded on the jobs from the start, so the game
+ * gets their ids right away and the first context waits on whatever is left of the decodes only
+ * after compiling its shaders.
+ */
 class Renderer {
 public:
+    // no window yet, textures are decoded on request and uploaded on attachWindow().
     explicit Renderer(Engine& engine, android_app *pApp) :
             engine(engine),
             app_(pApp),
             display_(EGL_NO_DISPLAY),
+            config_(nullptr),
             surface_(EGL_NO_SURFACE),
             context_(EGL_NO_CONTEXT),
             width_(0),
@@ -37,6 +59,13 @@ public:
     ~Renderer();
 
 public:
+    // draws into the app's current window. returns true when the GL resources had to be rebuilt,
+    // false when the context of the last window was still there.
+    bool attachWindow();
+    // the window is going away. drops its surface and keeps the context.
+    void detachWindow();
+    bool hasWindow() const { return surface_ != EGL_NO_SURFACE; }
+
     void render();
     void renderLayer(int type);
     GLuint getTextureId(std::string const& filepath);
@@ -46,23 +75,39 @@ public:
 
 private:
     /*!
-     * Performs necessary OpenGL initialization. Customize this if you want to change your EGL
-     * context or application-wide settings.
+     * Picks the display and config, decodes the built in textures and starts the preload. No GL yet.
      */
     void initRenderer();
 
+    // queues a decode per texture in the preload manifest, they take the first ids.
+    void preloadTextures();
+    // waits for the preload decodes, every preloaded texture is there (or failed) after it.
+    void finishPreload();
+    static void decodeJob(void* context, std::size_t begin, std::size_t end);
+
+    /*!
+     * Performs necessary OpenGL initialization in a new context, made current on surface_.
+     * Customize this if you want to change your EGL context or application-wide settings.
+     */
+    void createContext();
+    // the context is gone, so is everything in it. forgets its objects and destroys it.
+    void loseContext();
+
     /*!
      * @brief we have to check every frame to see if the framebuffer has changed in size. If it has,
      * update the viewport accordingly
      */
     void updateRenderArea();
-    // calculate the given model matrix for a game object.
-    static glm::mat4 calculateModelMatrix(GameObject const& gameObject);
+    // calculate the given model matrix for an entity.
+    static glm::mat4 calculateModelMatrix(Transform const& transform);
+    // fills drawItems from every entity with a Transform and a Sprite, on the jobs. no GL calls.
+    void extractDrawItems();
 
 private:
     Engine& engine;
     android_app *app_;
     EGLDisplay display_;
+    EGLConfig config_;
     EGLSurface surface_;
     EGLContext context_;
     EGLint width_;
@@ -71,13 +116,35 @@ private:
     bool shaderNeedsNewProjectionMatrix_;
 
     std::unique_ptr<Shader> mainShader;
+    ParticleRenderer particleRenderer;
+
+    // an entity as it's drawn, in query order.
+    struct DrawItem {
+        glm::mat4 model;
+        glm::vec4 colorMultiplier;
+        GLuint    textureId;
+        int       type;
+    };
+    // a chunk of the draw query and the first of its items.
+    struct DrawChunk {
+        Transform const* transforms;
+        Sprite const*    sprites;
+        std::size_t      first;
+    };
+    std::vector<DrawItem>  drawItems;
+    std::vector<DrawChunk> drawChunks;
 
     // owns all the texture.
     std::shared_ptr<TextureAsset> noneTexture;                      // none texture is a 1x1 white texture.
-    std::vector<std::shared_ptr<TextureAsset>> textures;            // owns all the textures
+    std::vector<std::shared_ptr<TextureAsset>> textures;            // owns all the textures, a texture id is its index
+    std::vector<GLuint> textureNames;                               // the GL texture of each id in the current context, 0 without one
 
-    std::unordered_map<std::string, GLuint> textureFilepathToId;    // maps all filepath to the corresponding texture id.. (NOT INDEX)
+    std::unordered_map<std::string, GLuint> textureFilepathToId;    // maps all filepath to the corresponding texture id..
                                                                     // we can do this because we are not unloading our textures..
+
+    std::vector<std::string> preloadPaths;                          // the manifest, texture id i is preloadPaths[i]
+    JobCounter preloadJobs;
+    bool preloading = false;                                        // decodes may still be writing textures[0, preloadPaths.size())
 };
 
 
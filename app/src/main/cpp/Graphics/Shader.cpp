@@ -5,8 +5,6 @@
 #include "../AndroidUtils/AndroidOut.h"
 #include "Model.h"
 
-#include "../Game/GameObject/GameObject.h"
-
 namespace {
     std::string readAssetText(AAssetManager* assetManager, const char* filename) {
         if (assetManager == nullptr) {
@@ -10,7 +10,6 @@
 
 class AAssetManager;
 class Model;
-class GameObject;
 
 /*!
  * A class representing a simple shader program. It consists of vertex and fragment components. The
@@ -33,6 +32,9 @@ public:
         }
     }
 
+    // the program died with its context, it's not deleted.
+    void abandon() { program_ = 0; }
+
     /*!
      * Prepares the shader for use, call this before executing any draw commands
      */
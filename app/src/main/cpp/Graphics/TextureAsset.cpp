@@ -10,6 +10,8 @@ std::shared_ptr<TextureAsset>
             assetManager,
             assetPath.c_str(),
             AASSET_MODE_BUFFER);
+    if (!pAndroidRobotPng)
+        return nullptr;
 
     // Make a decoder to turn it into a texture
     AImageDecoder *pAndroidDecoder = nullptr;
@@ -26,21 +28,43 @@ std::shared_ptr<TextureAsset>
     // important metrics for sending to GL
     auto width = AImageDecoderHeaderInfo_getWidth(pAndroidHeader);
     auto height = AImageDecoderHeaderInfo_getHeight(pAndroidHeader);
-    auto stride = AImageDecoder_getMinimumStride(pAndroidDecoder);
+    // tightly packed RGBA rows are 4 byte aligned, GL's default unpack alignment.
+    auto stride = static_cast<size_t>(width) * 4;
 
-    // Get the bitmap data of the image
-    auto upAndroidImageData = std::make_unique<std::vector<uint8_t>>(height * stride);
+    // Get the bitmap data of the image, kept for as long as the asset lives
+    std::vector<uint8_t> pixels(height * stride);
     auto decodeResult = AImageDecoder_decodeImage(
             pAndroidDecoder,
-            upAndroidImageData->data(),
+            pixels.data(),
             stride,
-            upAndroidImageData->size());
+            pixels.size());
     assert(decodeResult == ANDROID_IMAGE_DECODER_SUCCESS);
 
+    // cleanup helpers
+    AImageDecoder_delete(pAndroidDecoder);
+    AAsset_close(pAndroidRobotPng);
+
+    // Create a shared pointer so it can be cleaned up easily/automatically
+    return std::shared_ptr<TextureAsset>(new TextureAsset(width, height, std::move(pixels)));
+}
+
+TextureAsset::TextureAsset(int32_t width, int32_t height, std::vector<uint8_t> pixels) :
+        width_(width),
+        height_(height),
+        pixels_(std::move(pixels)),
+        textureID_(0) {}
+
+TextureAsset::~TextureAsset() {
+    // the renderer releases or abandons every texture before its context goes.
+    assert(textureID_ == 0);
+}
+
+void TextureAsset::upload() {
+    release();
+
     // Get an opengl texture
-    GLuint textureId;
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    glGenTextures(1, &textureID_);
+    glBindTexture(GL_TEXTURE_2D, textureID_);
 
     // Clamp to the edge, you'll get odd results alpha blending if you don't
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -54,27 +78,21 @@ std::shared_ptr<TextureAsset>
             GL_TEXTURE_2D, // target
             0, // mip level
             GL_RGBA, // internal format, often advisable to use BGR
-            width, // width of the texture
-            height, // height of the texture
+            width_, // width of the texture
+            height_, // height of the texture
             0, // border (always 0)
             GL_RGBA, // format
             GL_UNSIGNED_BYTE, // type
-            upAndroidImageData->data() // Data to upload
+            pixels_.data() // Data to upload
     );
 
     // generate mip levels. Not really needed for 2D, but good to do
     glGenerateMipmap(GL_TEXTURE_2D);
-
-    // cleanup helpers
-    AImageDecoder_delete(pAndroidDecoder);
-    AAsset_close(pAndroidRobotPng);
-
-    // Create a shared pointer so it can be cleaned up easily/automatically
-    return std::shared_ptr<TextureAsset>(new TextureAsset(textureId));
 }
 
-TextureAsset::~TextureAsset() {
+void TextureAsset::release() {
     // return texture resources
-    glDeleteTextures(1, &textureID_);
+    if (textureID_ != 0)
+        glDeleteTextures(1, &textureID_);
     textureID_ = 0;
-}
\ No newline at end of file
+}
@@ -7,27 +7,44 @@
 #include <string>
 #include <vector>
 
+/*!
+ * A decoded image and, while there is a GL context, the texture made from it.
+ *
+ * The RGBA pixels are kept after the upload, so a lost context is rebuilt with one glTexImage2D
+ * per texture instead of going back to the apk and the decoder.
+ */
 class TextureAsset {
 public:
     /*!
-     * Loads a texture asset from the assets/ directory
+     * Loads and decodes a texture asset from the assets/ directory, without touching GL
      * @param assetManager Asset manager to use
      * @param assetPath The path to the asset
-     * @return a shared pointer to a texture asset, resources will be reclaimed when it's cleaned up
+     * @return a shared pointer to a texture asset, nullptr when it can't be opened
      */
     static std::shared_ptr<TextureAsset> loadAsset(AAssetManager *assetManager, const std::string &assetPath);
 
     ~TextureAsset();
 
+    // creates the GL texture from the pixels, needs a current context.
+    void upload();
+    // deletes the GL texture, needs the context it was made in to be current.
+    void release();
+    // that context is gone, and the texture with it. the name means nothing any more.
+    void abandon() { textureID_ = 0; }
+
     /*!
-     * @return the texture id for use with OpenGL
+     * @return the texture id for use with OpenGL, 0 until it's uploaded
      */
     constexpr GLuint getTextureID() const { return textureID_; }
+    std::size_t getByteSize() const { return pixels_.size(); }
 
 private:
-    inline TextureAsset(GLuint textureId) : textureID_(textureId) {}
+    TextureAsset(int32_t width, int32_t height, std::vector<uint8_t> pixels);
 
+    int32_t width_;
+    int32_t height_;
+    std::vector<uint8_t> pixels_;     // RGBA8, rows tightly packed
     GLuint textureID_;
 };
 
-#endif //ANDROIDGLINVESTIGATIONS_TEXTUREASSET_H
\ No newline at end of file
+#endif //ANDROIDGLINVESTIGATIONS_TEXTUREASSET_H
@@ -0,0 +1,34 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AccelerometerPipeline.h"
+
+AccelerometerPipeline::AccelerometerPipeline(OneEuroFilter::Params const& params) :
+        filter { params }
+{}
+
+void AccelerometerPipeline::consume(SensorSample const* samples, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        SensorSample const& sample = samples[i];
+        if (!history.empty()) {
+            int64_t const gap = sample.timestampNs - history.back().timestampNs;
+            if (gap <= 0) {
+                ++dropped;
+                continue;
+            }
+            if (gap > maxGapNs) {
+                filter.reset();
+                filteredHistory.clear();
+            }
+        }
+        history.push(sample);
+        filteredHistory.push(SensorSample{sample.timestampNs, filter.filter(sample.value, sample.timestampNs)});
+    }
+}
+
+void AccelerometerPipeline::reset() {
+    filter.reset();
+    history.clear();
+    filteredHistory.clear();
+}
@@ -0,0 +1,55 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_ACCELEROMETERPIPELINE_H
+#define DOODLE_ACCELEROMETERPIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec3.hpp>
+
+#include "OneEuroFilter.h"
+#include "../Core/RingBuffer.h"
+
+// one raw reading, timestamp on the engine clock (see Core/Clock.h), in nanoseconds.
+struct SensorSample {
+    int64_t timestampNs;
+    glm::vec3 value;
+};
+
+/*!
+ * Platform independent half of the accelerometer input: takes raw samples in batches, keeps the
+ * recent history and filters them in timestamp order. The android side (AccelerometerSensor) only
+ * reads events off the sensor queue, so everything here can be driven on the host from a recorded
+ * trace (see tools/sensorreplay, and tools/sensorcheck for the checks).
+ */
+class AccelerometerPipeline {
+public:
+    static constexpr std::size_t historySize = 64;
+    // a gap longer than this (sensor was off, app paused..) restarts the filter instead of easing
+    // across it from a stale value.
+    static constexpr int64_t maxGapNs = 200'000'000;
+
+    explicit AccelerometerPipeline(OneEuroFilter::Params const& params = {});
+
+    void consume(SensorSample const* samples, std::size_t count);
+    void reset();
+
+    // latest filtered value, zero until the first sample arrives.
+    glm::vec3 filtered() const { return filter.value(); }
+    int64_t latestTimestampNs() const { return history.empty() ? 0 : history.back().timestampNs; }
+    RingBuffer<SensorSample, historySize> const& getHistory() const { return history; }
+    // the filter's output after each accepted sample, what prediction extrapolates from.
+    RingBuffer<SensorSample, historySize> const& getFilteredHistory() const { return filteredHistory; }
+    // samples rejected for going back in time.
+    uint32_t droppedSamples() const { return dropped; }
+
+private:
+    OneEuroFilter filter;
+    RingBuffer<SensorSample, historySize> history;
+    RingBuffer<SensorSample, historySize> filteredHistory;
+    uint32_t dropped = 0;
+};
+
+#endif //DOODLE_ACCELEROMETERPIPELINE_H
@@ -0,0 +1,88 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "AccelerometerSensor.h"
+
+#include <algorithm>
+
+#include "../AndroidUtils/AndroidOut.h"
+#include "../Core/Clock.h"
+#include "../Core/Log.h"
+
+AccelerometerSensor::~AccelerometerSensor() {
+    if (queue != nullptr) {
+        if (mode != SensorMode::Off)
+            ASensorEventQueue_disableSensor(queue, sensor);
+        ASensorManager_destroyEventQueue(manager, queue);
+    }
+}
+
+bool AccelerometerSensor::init(ALooper* looper, int looperId, void* pollSource) {
+    manager = ASensorManager_getInstance();
+    if (manager == nullptr) {
+        aout << "Unable to get Sensor Manager" << std::endl;
+        return false;
+    }
+    sensor = ASensorManager_getDefaultSensor(manager, ASENSOR_TYPE_ACCELEROMETER);
+    if (sensor == nullptr) {
+        aout << "Unable to get Accelerometer" << std::endl;
+        return false;
+    }
+    queue = ASensorManager_createEventQueue(manager, looper, looperId, nullptr, pollSource);
+    if (queue == nullptr) {
+        aout << "Unable to create the sensor event queue" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool AccelerometerSensor::setMode(SensorMode newMode) {
+    if (newMode == mode || queue == nullptr)
+        return false;
+
+    if (newMode == SensorMode::Off) {
+        ASensorEventQueue_disableSensor(queue, sensor);
+    } else {
+        int32_t const period = std::max(ASensor_getMinDelay(sensor), gameplayPeriodUs);
+        if (ASensorEventQueue_registerSensor(queue, sensor, period, gameplayBatchLatencyUs) < 0) {
+            aout << "Unable to enable Accelerometer" << std::endl;
+            return false;
+        }
+    }
+    mode = newMode;
+    return true;
+}
+
+void AccelerometerSensor::drain(InputQueue& input) {
+    if (queue == nullptr)
+        return;
+
+    ASensorEvent events[readBatch];
+    ssize_t count;
+    while ((count = ASensorEventQueue_getEvents(queue, events, readBatch)) > 0) {
+        // still flushing events queued before the sensor was turned off.
+        if (mode == SensorMode::Off)
+            continue;
+
+        for (ssize_t i = 0; i < count; ++i) {
+            ASensorEvent const& event = events[i];
+            if (event.type != ASENSOR_TYPE_ACCELEROMETER)
+                continue;
+            input.push(InputEvent{
+                    Clock::boottimeToMonotonicNs(event.timestamp),
+                    InputEventType::Tilt,
+                    TouchAction::None,
+                    0,
+                    event.acceleration.x,
+                    event.acceleration.y,
+                    event.acceleration.z
+            });
+#ifdef DOODLE_SENSOR_TRACE
+            // raw samples for tools/sensorreplay.
+            DOODLE_LOGD("DoodleInput", "accel,%lld,%f,%f,%f", event.timestamp,
+                        event.acceleration.x, event.acceleration.y, event.acceleration.z);
+#endif
+        }
+    }
+}
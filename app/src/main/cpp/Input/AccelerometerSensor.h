@@ -0,0 +1,60 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_ACCELEROMETERSENSOR_H
+#define DOODLE_ACCELEROMETERSENSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <android/looper.h>
+#include <android/sensor.h>
+
+#include "InputQueue.h"
+
+enum class SensorMode {
+    Off,        // menus, game over.. nothing reads tilt, so the sensor is released
+    Gameplay
+};
+
+/*!
+ * Android side of the accelerometer: owns the sensor event queue on the game thread's looper and
+ * turns what it reads into tilt events on the engine clock. Filtering happens once the simulation
+ * consumes them (see AccelerometerPipeline).
+ *
+ * In gameplay the sensor is registered at a fixed rate with hardware batching, so on devices with
+ * a sensor FIFO the looper is woken about once per frame with a batch of samples instead of once
+ * per sample. Events are read in bulk.
+ */
+class AccelerometerSensor {
+public:
+    static constexpr int32_t     gameplayPeriodUs       = 10'000;   // 100 Hz
+    static constexpr int64_t     gameplayBatchLatencyUs = 16'000;   // about one frame
+    static constexpr std::size_t readBatch              = 32;
+
+    AccelerometerSensor() = default;
+    ~AccelerometerSensor();
+
+    AccelerometerSensor(AccelerometerSensor const&) = delete;
+    AccelerometerSensor& operator=(AccelerometerSensor const&) = delete;
+
+    // creates the event queue, its events wake the looper with looperId / pollSource. the sensor
+    // stays off until setMode is called.
+    bool init(ALooper* looper, int looperId, void* pollSource);
+
+    // cheap to call every frame, only touches the sensor when the mode changes. returns true when it
+    // did, anything filtered before belongs to another session then.
+    bool setMode(SensorMode mode);
+    SensorMode getMode() const { return mode; }
+
+    // reads everything queued into input, call from the looper callback.
+    void drain(InputQueue& input);
+
+private:
+    ASensorManager* manager = nullptr;
+    ASensorEventQueue* queue = nullptr;
+    const ASensor* sensor = nullptr;
+    SensorMode mode = SensorMode::Off;
+};
+
+#endif //DOODLE_ACCELEROMETERSENSOR_H
@@ -0,0 +1,39 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_INPUTEVENT_H
+#define DOODLE_INPUTEVENT_H
+
+#include <cstdint>
+
+enum class InputEventType : uint8_t {
+    Touch,
+    Tilt
+};
+
+enum class TouchAction : uint8_t {
+    None,       // tilt events
+    Down,
+    Move,
+    Up          // also sent for cancel
+};
+
+/*!
+ * One input sample as the simulation sees it. Plain data so it can be copied around and stored in
+ * fixed arrays without touching the heap.
+ *
+ * timestampNs is when the hardware produced the sample, on the engine clock (CLOCK_MONOTONIC, see
+ * Core/Clock.h). For touches x and y are in window pixels, for tilt x, y and z are m/s^2.
+ */
+struct InputEvent {
+    int64_t timestampNs;
+    InputEventType type;
+    TouchAction action;
+    uint8_t pointerId;
+    float x;
+    float y;
+    float z;
+};
+
+#endif //DOODLE_INPUTEVENT_H
@@ -0,0 +1,59 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_INPUTQUEUE_H
+#define DOODLE_INPUTQUEUE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "InputEvent.h"
+
+/*!
+ * Input gathered on the game thread between two simulation steps.
+ *
+ * Touches and sensor samples come from different queues at different times, so they are appended
+ * as they are read and put back in hardware timestamp order once per frame, when the simulation
+ * consumes them. Storage is fixed, events that don't fit are counted and dropped.
+ */
+class InputQueue {
+public:
+    static constexpr std::size_t capacity = 256;
+
+    void push(InputEvent const& event) {
+        if (count == capacity) {
+            ++dropped;
+            return;
+        }
+        events[count++] = event;
+    }
+
+    // hands every pending event to handler, oldest first, and empties the queue.
+    template <typename Handler>
+    void consume(Handler&& handler) {
+        // each source is already in order, so an insertion sort has little to move, is stable and
+        // doesn't allocate like std::stable_sort may.
+        for (std::size_t i = 1; i < count; ++i) {
+            InputEvent const event = events[i];
+            std::size_t j = i;
+            for (; j > 0 && events[j - 1].timestampNs > event.timestampNs; --j)
+                events[j] = events[j - 1];
+            events[j] = event;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+            handler(events[i]);
+        count = 0;
+    }
+
+    std::size_t size() const { return count; }
+    uint32_t droppedEvents() const { return dropped; }
+
+private:
+    std::array<InputEvent, capacity> events{};
+    std::size_t count = 0;
+    uint32_t dropped = 0;
+};
+
+#endif //DOODLE_INPUTQUEUE_H
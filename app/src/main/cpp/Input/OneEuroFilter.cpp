@@ -0,0 +1,48 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "OneEuroFilter.h"
+
+#include <glm/common.hpp>
+#include <glm/ext/scalar_constants.hpp>
+
+OneEuroFilter::OneEuroFilter(Params const& params) :
+        params { params }
+{}
+
+glm::vec3 OneEuroFilter::filter(glm::vec3 value, int64_t timestampNs) {
+    if (!initialized) {
+        initialized = true;
+        previousTimestampNs = timestampNs;
+        previous = value;
+        previousDerivative = glm::vec3{0.f};
+        return previous;
+    }
+    if (timestampNs <= previousTimestampNs)
+        return previous;
+
+    float const dt = static_cast<float>(timestampNs - previousTimestampNs) * 1e-9f;
+    previousTimestampNs = timestampNs;
+
+    // smoothed speed of the signal, drives the cutoff below.
+    glm::vec3 const derivative = (value - previous) / dt;
+    previousDerivative = glm::mix(previousDerivative, derivative, alpha(params.derivativeCutoffHz, dt));
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float const cutoff = params.minCutoffHz + params.beta * glm::abs(previousDerivative[axis]);
+        previous[axis] = glm::mix(previous[axis], value[axis], alpha(cutoff, dt));
+    }
+    return previous;
+}
+
+void OneEuroFilter::reset() {
+    initialized = false;
+    previous = glm::vec3{0.f};
+    previousDerivative = glm::vec3{0.f};
+}
+
+float OneEuroFilter::alpha(float cutoffHz, float dt) {
+    float const tau = 1.f / (2.f * glm::pi<float>() * cutoffHz);
+    return 1.f / (1.f + tau / dt);
+}
@@ -0,0 +1,49 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_ONEEUROFILTER_H
+#define DOODLE_ONEEUROFILTER_H
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+
+/*!
+ * One euro filter (Casiez et al.) on a 3 component signal.
+ *
+ * An adaptive low-pass: while the signal is steady the cutoff stays at minCutoffHz and jitter is
+ * smoothed away, when it moves fast the cutoff rises with the speed (scaled by beta) so lag stays
+ * low. It works from the samples' own timestamps, so irregular or batched delivery doesn't change
+ * the response.
+ */
+class OneEuroFilter {
+public:
+    struct Params {
+        float minCutoffHz        = 2.f;     // smoothing when the signal is at rest
+        float beta               = 0.2f;    // how fast the cutoff opens with speed
+        float derivativeCutoffHz = 1.f;     // smoothing of the speed estimate itself
+    };
+
+    OneEuroFilter() = default;
+    explicit OneEuroFilter(Params const& params);
+
+    // filters one sample, timestamps are in nanoseconds and must increase. samples that don't move
+    // time forward are ignored and the previous output is returned.
+    glm::vec3 filter(glm::vec3 value, int64_t timestampNs);
+
+    void reset();
+    bool hasValue() const { return initialized; }
+    glm::vec3 value() const { return previous; }
+    Params const& getParams() const { return params; }
+
+private:
+    static float alpha(float cutoffHz, float dt);
+
+    Params params{};
+    bool initialized = false;
+    int64_t previousTimestampNs = 0;
+    glm::vec3 previous{0.f};
+    glm::vec3 previousDerivative{0.f};
+};
+
+#endif //DOODLE_ONEEUROFILTER_H
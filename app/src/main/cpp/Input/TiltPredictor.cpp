@@ -0,0 +1,50 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#include "TiltPredictor.h"
+
+#include <algorithm>
+#include <glm/common.hpp>
+
+TiltPredictor::TiltPredictor(Params const& params) :
+        params { params }
+{}
+
+glm::vec3 TiltPredictor::predict(AccelerometerPipeline const& pipeline, int64_t targetNs) const {
+    auto const& history = pipeline.getFilteredHistory();
+    if (history.empty())
+        return glm::vec3{0.f};
+
+    SensorSample const& newest = history.back();
+    int64_t const lead = std::clamp<int64_t>(targetNs - newest.timestampNs, 0, params.maxLeadNs);
+    if (lead == 0 || history.size() < 3)
+        return newest.value;
+
+    // least squares slope over the window, times relative to the newest sample (in seconds) so the
+    // sums stay small enough for floats.
+    float sumT = 0.f;
+    float sumTT = 0.f;
+    glm::vec3 sumV{0.f};
+    glm::vec3 sumTV{0.f};
+    int count = 0;
+    for (std::size_t i = history.size(); i-- > 0;) {
+        SensorSample const& sample = history[i];
+        int64_t const age = newest.timestampNs - sample.timestampNs;
+        if (age > params.windowNs)
+            break;
+        float const t = static_cast<float>(-age) * 1e-9f;
+        sumT += t;
+        sumTT += t * t;
+        sumV += sample.value;
+        sumTV += t * sample.value;
+        ++count;
+    }
+    float const denominator = static_cast<float>(count) * sumTT - sumT * sumT;
+    if (count < 3 || denominator <= 0.f)
+        return newest.value;
+
+    glm::vec3 const slope = (static_cast<float>(count) * sumTV - sumT * sumV) / denominator;
+    glm::vec3 const predicted = newest.value + slope * (static_cast<float>(lead) * 1e-9f);
+    return glm::clamp(predicted, glm::vec3{-params.maxMagnitude}, glm::vec3{params.maxMagnitude});
+}
@@ -0,0 +1,38 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+
+#ifndef DOODLE_TILTPREDICTOR_H
+#define DOODLE_TILTPREDICTOR_H
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+
+#include "AccelerometerPipeline.h"
+
+/*!
+ * Estimates the tilt at a future time (the frame's expected present) from the filtered samples.
+ *
+ * A line is fitted through the last `window` of filtered samples by least squares and followed from
+ * the newest sample to the target time. The lead is capped, so a stalled sensor or a long frame
+ * never turns into a large overshoot, and the result is kept within the accelerometer's range.
+ */
+class TiltPredictor {
+public:
+    struct Params {
+        int64_t windowNs     = 50'000'000;    // samples used for the slope
+        int64_t maxLeadNs    = 40'000'000;    // furthest we extrapolate past the newest sample
+        float   maxMagnitude = 9.81f * 2.f;   // per axis clamp, m/s^2
+    };
+
+    TiltPredictor() = default;
+    explicit TiltPredictor(Params const& params);
+
+    // falls back to the newest filtered value when there isn't enough history for a slope.
+    glm::vec3 predict(AccelerometerPipeline const& pipeline, int64_t targetNs) const;
+
+private:
+    Params params{};
+};
+
+#endif //DOODLE_TILTPREDICTOR_H
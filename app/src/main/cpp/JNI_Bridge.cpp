@@ -1,79 +1,15 @@
 #include "JNI_Bridge.h"
+#include <algorithm>
+#include <iterator>
 #include <game-activity/native_app_glue/android_native_app_glue.h>
 #include <jni.h>
-#include "AndroidUtils/AndroidOut.h" // For logging
 #include "Engine.h"
+#include "Core/UiEventChannel.h"
+#include "Core/Telemetry.h"
 
 extern Engine* g_Engine;
 
 
-void JNI_UpdateScore(android_app* app, int score) {
-    if (!app || !app->activity || !app->activity->vm) {
-        return;
-    }
-
-    JNIEnv* env = nullptr;
-    JavaVM* vm = app->activity->vm;
-
-    // 1. Attach current thread (Game Loop) to the Java VM
-    jint result = vm->AttachCurrentThread(&env, nullptr);
-    if (result != JNI_OK) {
-        aout << "Failed to attach thread for JNI" << std::endl;
-        return;
-    }
-
-    // 2. Get the Activity instance
-    jobject activityCallback = app->activity->javaGameActivity;
-
-    // 3. Find our MainActivity class
-    jclass activityClass = env->GetObjectClass(activityCallback);
-
-    // 4. Get the Kotlin method ID: fun setScore(score: Int)
-    // Signature (I)V means takes Integer, returns Void
-    jmethodID methodId = env->GetMethodID(activityClass, "setScore", "(I)V");
-
-    if (methodId != nullptr) {
-        // 5. Call the method
-        env->CallVoidMethod(activityCallback, methodId, score);
-    } else {
-        // This often happens if the method name/signature in Kotlin doesn't match exactly
-        // clearing exception is important so app doesn't crash on next JNI call
-        env->ExceptionClear();
-        aout << "Could not find method setScore in MainActivity" << std::endl;
-    }
-
-    // 6. Clean up references
-    env->DeleteLocalRef(activityClass);
-
-    // 7. Detach thread (Crucial for performance and stability)
-    vm->DetachCurrentThread();
-}
-
-void JNI_GameOver(android_app* app, int score) {
-    if (!app || !app->activity || !app->activity->vm) return;
-
-    JNIEnv* env = nullptr;
-    JavaVM* vm = app->activity->vm;
-
-    if (vm->AttachCurrentThread(&env, nullptr) != JNI_OK) return;
-
-    jobject activityCallback = app->activity->javaGameActivity;
-    jclass activityClass = env->GetObjectClass(activityCallback);
-
-    // Look for "gameOver" instead of "setScore"
-    jmethodID methodId = env->GetMethodID(activityClass, "gameOver", "(I)V");
-
-    if (methodId != nullptr) {
-        env->CallVoidMethod(activityCallback, methodId, score);
-    } else {
-        env->ExceptionClear();
-        aout << "Could not find method gameOver in MainActivity" << std::endl;
-    }
-
-    env->DeleteLocalRef(activityClass);
-    vm->DetachCurrentThread();
-}
-
 extern "C" {
 JNIEXPORT void JNICALL
 Java_com_example_doodle_MainActivity_restartGameNative(JNIEnv *env, jobject thiz) {
@@ -91,10 +27,44 @@ Java_com_example_doodle_MainActivity_startGameNative(JNIEnv *env, jobject thiz)
     }
 }
 
+JNIEXPORT void JNICALL
+Java_com_example_doodle_MainActivity_setAutopilotNative(JNIEnv *env, jobject thiz, jboolean enabled) {
+    // process wide, so it can be set before the engine exists and survives it being recreated.
+    setAutopilotEnabled(enabled == JNI_TRUE);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_example_doodle_MainActivity_drainUiEvents(JNIEnv *env, jobject thiz, jintArray buffer) {
+    // One crossing per UI frame, the whole batch is copied in a single region write.
+    UiEvent events[UiEventChannel::capacity + 1];
+    std::size_t const room = std::min<std::size_t>(env->GetArrayLength(buffer) / 2, std::size(events));
+    std::size_t const count = uiEvents().drain(events, room);
+    if (count > 0) {
+        env->SetIntArrayRegion(buffer, 0, static_cast<jsize>(count * 2), reinterpret_cast<const jint*>(events));
+    }
+    return static_cast<jint>(count);
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_example_doodle_MainActivity_telemetryBuffer(JNIEnv *env, jobject thiz) {
+    // The block is process wide, so the buffer never dangles even when the engine is recreated.
+    Telemetry& block = telemetry();
+    return env->NewDirectByteBuffer(block.data(), static_cast<jlong>(Telemetry::size()));
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_doodle_MainActivity_readTelemetryNative(JNIEnv *env, jobject thiz, jfloatArray values) {
+    // Before API 33 Kotlin has no acquire fence, so the seqlock is read here. Same slots as MainActivity.
+    TelemetrySnapshot const snapshot = telemetry().read();
+    jfloat const copy[] = { snapshot.height, snapshot.fps, snapshot.frameTimeMs };
+    env->SetFloatArrayRegion(values, 0, static_cast<jsize>(std::size(copy)), copy);
+}
+
 }
 
 void Java_com_example_doodle_MainActivity_playMenuBGM(JNIEnv *env, jobject thiz) {
+    // UI thread, the game thread starts the track on its next update.
     if(g_Engine){
-        g_Engine->playAudio("menuBGM.mp3", true);
+        g_Engine->requestMenuMusic();
     }
 }
@@ -5,11 +5,7 @@
 #include <jni.h>
 
 
-
-
-// Engine to UI Helper Functions
-void JNI_UpdateScore(android_app* app, int score);
-void JNI_GameOver(android_app* app, int score);
+// Engine to UI goes through uiEvents() (Core/UiEventChannel.h), the UI pulls with drainUiEvents.
 
 // UI to Engine (The JNI Export Declaration)
 extern "C" {
@@ -18,6 +14,18 @@ Java_com_example_doodle_MainActivity_startGameNative(JNIEnv *env, jobject thiz);
 
 JNIEXPORT void JNICALL
 Java_com_example_doodle_MainActivity_playMenuBGM(JNIEnv *env, jobject thiz);
+
+// Fills buffer with (type, value) pairs and returns the number of events written.
+JNIEXPORT jint JNICALL
+Java_com_example_doodle_MainActivity_drainUiEvents(JNIEnv *env, jobject thiz, jintArray buffer);
+
+// Wraps the native telemetry block (Core/Telemetry.h) without copying, call once.
+JNIEXPORT jobject JNICALL
+Java_com_example_doodle_MainActivity_telemetryBuffer(JNIEnv *env, jobject thiz);
+
+// Copies height, fps and frame time out with the seqlock read, for the UI below API 33.
+JNIEXPORT void JNICALL
+Java_com_example_doodle_MainActivity_readTelemetryNative(JNIEnv *env, jobject thiz, jfloatArray values);
 }
 
 #endif //DOODLE_JNI_BRIDGE_H
@@ -7,6 +7,9 @@
 
 #include "AndroidUtils/AndroidOut.h"
 #include "Engine.h"
+#include "JNI_Bridge.h"
+#include "Core/Log.h"
+#include "Core/StartupTrace.h"
 
 // 1. Add global pointer at the top, this is used to call functions on the engine from JNI.
 // You can replace this with a more robust solution if you want,
@@ -23,25 +26,24 @@ extern "C" {
 void handle_cmd(android_app *pApp, int32_t cmd) {
     switch (cmd) {
         case APP_CMD_INIT_WINDOW:
-            // A new window is created, associate a renderer with it. You may replace this with a
-            // "game" class if that suits your needs. Remember to change all instances of userData
-            // if you change the class here as a reinterpret_cast is dangerous this in the
-            // android_main function and the APP_CMD_TERM_WINDOW handler case.
-            pApp->userData = new Engine(pApp);
-            g_Engine = reinterpret_cast<Engine*>(pApp->userData);
+            // A new window is created. The engine is made with the first one and outlives the
+            // rest, so coming back from the background resumes the same run. Remember to change
+            // all instances of userData if you change the class here as a reinterpret_cast is
+            // dangerous this in the android_main function and the APP_CMD_TERM_WINDOW handler case.
+            if (!pApp->userData) {
+                StartupTrace::Scope stage{startupTrace(), "engine"};
+                pApp->userData = new Engine(pApp);
+                g_Engine = reinterpret_cast<Engine*>(pApp->userData);
+            }
+            reinterpret_cast<Engine*>(pApp->userData)->attachWindow();
             break;
         case APP_CMD_TERM_WINDOW:
-            // The window is being destroyed. Use this to clean up your userData to avoid leaking
-            // resources.
+            // The window is being destroyed. Only its surface goes with it, the engine is deleted
+            // when android_main returns.
             //
             // We have to check if userData is assigned just in case this comes in really quickly
             if (pApp->userData) {
-                //
-                auto *pEngine = reinterpret_cast<Engine *>(pApp->userData);
-                pApp->userData = nullptr;
-                g_Engine = nullptr;
-                delete pEngine;
-
+                reinterpret_cast<Engine *>(pApp->userData)->detachWindow();
             }
             break;
         default:
@@ -68,6 +70,11 @@ bool motion_event_filter_func(const GameActivityMotionEvent *motionEvent) {
  * This the main entry point for a native activity
  */
 void android_main(struct android_app *pApp) {
+    // Everything logged from here on is written out by the log thread, not by the caller.
+    Log::start();
+    // the time to first frame is measured from here, see Engine::render.
+    startupTrace().start();
+
     // Can be removed, useful to ensure your code is running
     aout << "Welcome to android_main" << std::endl;
 
@@ -79,17 +86,20 @@ void android_main(struct android_app *pApp) {
     // implemented in android_native_app_glue.c.
     android_app_set_motion_event_filter(pApp, motion_event_filter_func);
 
-    // Initialize the time point for the previous frame
+    // The time point of the previous frame, and whether there was one since the window came back
     auto lastFrameTime = std::chrono::steady_clock::now();
-    float deltaTime = 0.f;
+    bool running = false;
 
     // This sets up a typical game/event loop. It will run until the app is destroyed.
     do {
         // Process all pending events before running game logic.
         bool done = false;
         while (!done) {
-            // 0 is non-blocking.
-            int timeout = 0;
+            // 0 is non-blocking. Without a window there's nothing to do until the next event, so
+            // wait for it instead of spinning in the background.
+            auto const *pWaiting = reinterpret_cast<Engine *>(pApp->userData);
+            bool const idle = !pApp->destroyRequested && !(pWaiting && pWaiting->hasWindow());
+            int timeout = idle ? -1 : 0;
             int events;
             android_poll_source *pSource;
             int result = ALooper_pollOnce(timeout, nullptr, &events,
@@ -114,10 +124,15 @@ void android_main(struct android_app *pApp) {
         }
 
         // Check if any user data is associated. This is assigned in handle_cmd
-        if (pApp->userData) {
-            // We know that our user data is a Engine, so reinterpret cast it. If you change your
-            // user data remember to change it here
-            auto *pEngine = reinterpret_cast<Engine *>(pApp->userData);
+        auto *pEngine = reinterpret_cast<Engine *>(pApp->userData);
+        if (pEngine && pEngine->hasWindow()) {
+            // Get the current time point, the first frame after a (re)start doesn't step over
+            // the time spent without a window.
+            auto currentTime = std::chrono::steady_clock::now();
+            std::chrono::duration<float> deltaTimeDuration = currentTime - lastFrameTime;
+            lastFrameTime = currentTime;
+            float const deltaTime = running ? deltaTimeDuration.count() : 0.f;
+            running = true;
 
             static bool audioBool = false;
             if(!audioBool){
@@ -135,19 +150,18 @@ void android_main(struct android_app *pApp) {
             // Render a frame
             pEngine->render();
         }
+        else {
+            running = false;
+        }
+    } while (!pApp->destroyRequested);
 
-        // Get the current time point
-        auto currentTime = std::chrono::steady_clock::now();
-
-        // Calculate the difference between the current and last frame's time points
-        std::chrono::duration<float> deltaTimeDuration = currentTime - lastFrameTime;
-
-        // Store the current time for the next iteration
-        lastFrameTime = currentTime;
-
-        // Get the delta time in seconds as a float
-        deltaTime = deltaTimeDuration.count();
+    if (pApp->userData) {
+        auto *pEngine = reinterpret_cast<Engine *>(pApp->userData);
+        pApp->userData = nullptr;
+        g_Engine = nullptr;
+        delete pEngine;
+    }
 
-    } while (!pApp->destroyRequested);
+    Log::stop();
 }
 }
\ No newline at end of file
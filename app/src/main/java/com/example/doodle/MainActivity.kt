@@ -1,7 +1,9 @@
 package com.example.doodle
 
+import android.os.Build
 import android.os.Bundle
 import android.util.Log
+import android.view.Choreographer
 import android.view.View
 import android.view.ViewGroup
 import android.widget.FrameLayout
@@ -50,6 +52,9 @@ import com.example.doodle.data.HighScoreEntity
 import com.google.androidgamesdk.GameActivity
 import kotlinx.coroutines.flow.firstOrNull
 import kotlinx.coroutines.launch
+import java.lang.invoke.VarHandle
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 import java.util.UUID
 import androidx.compose.material3.AlertDialog
 import androidx.compose.material3.OutlinedTextField
@@ -83,15 +88,59 @@ class MainActivity : GameActivity() {
     private val currentScore = mutableIntStateOf(0)
     private val currentScreen = mutableStateOf(ScreenState.START_MENU)
 
+    // Live values read from the native telemetry block, only written when they change
+    private lateinit var telemetry: ByteBuffer
+    private val telemetryValues = FloatArray(TELEMETRY_VALUE_COUNT)
+    private val currentHeight = mutableIntStateOf(0)
+    private val currentFps = mutableIntStateOf(0)
+    private val frameTimeTenthsMs = mutableIntStateOf(0)
+
     // Theme Colors derived from your screenshot
     private val themeRed = Color(0xFFD32F2F) // Red for platforms/buttons
     private val themeBlack = Color.Black
     private val themeWhite = Color.White
 
+    // Native events are pulled once per frame instead of being pushed from the game thread.
+    private val uiEventBuffer = IntArray(UI_EVENT_BUFFER_SIZE * 2)
+    private val uiEventPump = object : Choreographer.FrameCallback {
+        override fun doFrame(frameTimeNanos: Long) {
+            drainNativeEvents()
+            readTelemetry()
+            Choreographer.getInstance().postFrameCallback(this)
+        }
+    }
+
     companion object {
         init {
             System.loadLibrary("doodle")
         }
+
+        // Mirrors UiEventType in Core/UiEventChannel.h
+        private const val UI_EVENT_SCORE_CHANGED = 1
+        private const val UI_EVENT_GAME_OVER = 2
+        private const val UI_EVENT_STATE_CHANGED = 3
+
+        // Mirrors DoodleGame::GameState
+        private const val GAME_STATE_PLAYING = 2
+
+        // Native ring capacity plus the coalesced score slot
+        private const val UI_EVENT_BUFFER_SIZE = 33
+
+        // Byte offsets in the telemetry block, mirrors Core/Telemetry.h
+        private const val TELEMETRY_SEQUENCE = 0
+        private const val TELEMETRY_HEIGHT = 8
+        private const val TELEMETRY_FPS = 12
+        private const val TELEMETRY_FRAME_TIME = 16
+
+        // Slots filled by readTelemetryNative
+        private const val TELEMETRY_VALUE_HEIGHT = 0
+        private const val TELEMETRY_VALUE_FPS = 1
+        private const val TELEMETRY_VALUE_FRAME_TIME = 2
+        private const val TELEMETRY_VALUE_COUNT = 3
+
+        // Lets the bot play, for soak and benchmark runs:
+        // adb shell am start -n com.example.doodle/.MainActivity --ez autopilot true
+        private const val EXTRA_AUTOPILOT = "autopilot"
     }
 
 
@@ -107,7 +156,13 @@ class MainActivity : GameActivity() {
     override fun onCreate(savedInstanceState: Bundle?) {
         super.onCreate(savedInstanceState)
 
+        // Without the extra the build decides (DOODLE_AUTOPILOT).
+        if (intent.hasExtra(EXTRA_AUTOPILOT)) {
+            setAutopilotNative(intent.getBooleanExtra(EXTRA_AUTOPILOT, false))
+        }
+
         dao = GameDatabase.getInstance(this).highScoreDao()
+        telemetry = telemetryBuffer().order(ByteOrder.nativeOrder())
 
         lifecycleScope.launch {
             dao.getTopScores().collect { topScores.value = it }
@@ -140,6 +195,17 @@ class MainActivity : GameActivity() {
         addContentView(composeView, params)
     }
 
+    override fun onResume() {
+        super.onResume()
+        Choreographer.getInstance().postFrameCallback(uiEventPump)
+    }
+
+    override fun onPause() {
+        // Events keep queueing natively and are picked up again on resume.
+        Choreographer.getInstance().removeFrameCallback(uiEventPump)
+        super.onPause()
+    }
+
 
 //    private fun restartGame() {
 //        // Simple restart by recreating activity for now
@@ -149,25 +215,73 @@ class MainActivity : GameActivity() {
 
 
     //----Engine to UI functions----
-    fun setScore(score: Int) {
-        // C++ runs on a background thread. UI updates must happen on Main Thread.
-        runOnUiThread {
-            currentScore.intValue = score
+    external fun drainUiEvents(buffer: IntArray): Int
+
+    // Runs on the main thread from the frame callback, so no runOnUiThread and no allocation.
+    private fun drainNativeEvents() {
+        val count = drainUiEvents(uiEventBuffer)
+        for (i in 0 until count) {
+            val value = uiEventBuffer[i * 2 + 1]
+            when (uiEventBuffer[i * 2]) {
+                UI_EVENT_SCORE_CHANGED -> currentScore.intValue = value
+                UI_EVENT_GAME_OVER -> gameOver(value)
+                UI_EVENT_STATE_CHANGED -> onNativeStateChanged(value)
+            }
         }
     }
 
-    fun gameOver(finalScore: Int) {
-        runOnUiThread {
-            currentScore.intValue = finalScore
-            pendingScore.intValue = finalScore
-
-            if (getSavedUsername() == null) {
-                showUsernameDialog.value = true
-                currentScreen.value = ScreenState.GAME_OVER
-            } else {
-                currentScreen.value = ScreenState.GAME_OVER
-                persistScore(finalScore, getSavedUsername()!!)
-            }
+    external fun telemetryBuffer(): ByteBuffer
+
+    // Copies the snapshot through the native seqlock read, for releases without a public fence.
+    external fun readTelemetryNative(values: FloatArray)
+
+    private fun readTelemetry() {
+        var height: Float
+        var fps: Float
+        var frameTime: Float
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) {
+            // Seqlock read of the shared block: retry until the sequence is even and unchanged across the copy.
+            do {
+                val before = telemetry.getInt(TELEMETRY_SEQUENCE)
+                VarHandle.acquireFence()
+                height = telemetry.getFloat(TELEMETRY_HEIGHT)
+                fps = telemetry.getFloat(TELEMETRY_FPS)
+                frameTime = telemetry.getFloat(TELEMETRY_FRAME_TIME)
+                VarHandle.acquireFence()
+                val after = telemetry.getInt(TELEMETRY_SEQUENCE)
+            } while ((before and 1) != 0 || before != after)
+        } else {
+            // Without the fences the plain buffer loads may be reordered around the sequence reads,
+            // so a torn frame could pass the check. One JNI call per frame instead.
+            readTelemetryNative(telemetryValues)
+            height = telemetryValues[TELEMETRY_VALUE_HEIGHT]
+            fps = telemetryValues[TELEMETRY_VALUE_FPS]
+            frameTime = telemetryValues[TELEMETRY_VALUE_FRAME_TIME]
+        }
+
+        // Compose skips the write when the value is the same, so an idle HUD doesn't recompose.
+        currentHeight.intValue = height.toInt()
+        currentFps.intValue = Math.round(fps)
+        frameTimeTenthsMs.intValue = Math.round(frameTime * 10f)
+    }
+
+    private fun onNativeStateChanged(state: Int) {
+        // Keep the overlay in sync if the game starts playing without going through the menu.
+        if (state == GAME_STATE_PLAYING && currentScreen.value != ScreenState.PLAYING) {
+            currentScreen.value = ScreenState.PLAYING
+        }
+    }
+
+    private fun gameOver(finalScore: Int) {
+        currentScore.intValue = finalScore
+        pendingScore.intValue = finalScore
+
+        if (getSavedUsername() == null) {
+            showUsernameDialog.value = true
+            currentScreen.value = ScreenState.GAME_OVER
+        } else {
+            currentScreen.value = ScreenState.GAME_OVER
+            persistScore(finalScore, getSavedUsername()!!)
         }
     }
 
@@ -229,6 +343,8 @@ class MainActivity : GameActivity() {
 
     external fun restartGameNative()
 
+    external fun setAutopilotNative(enabled: Boolean)
+
     fun restartGame() {
         // 2. Reset UI State
         currentScore.intValue = 0
@@ -449,6 +565,13 @@ class MainActivity : GameActivity() {
                     fontSize = 24.sp,
                     fontFamily = FontFamily.Monospace
                 )
+                Text(
+                    text = "${currentHeight.intValue} m  ${currentFps.intValue} fps  " +
+                        "${frameTimeTenthsMs.intValue / 10}.${frameTimeTenthsMs.intValue % 10} ms",
+                    color = Color.Gray,
+                    fontSize = 11.sp,
+                    fontFamily = FontFamily.Monospace
+                )
             }
         }
     }
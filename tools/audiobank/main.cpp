@@ -0,0 +1,329 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Packs 16-bit wav files into a single audio bank (see Audio/AudioBank.h) for the game, and
+// inspects existing banks. Music in the apk is mp3, convert it to wav first, e.g.
+//
+//     ffmpeg -i BGM.mp3 BGM.wav
+//     audiobank pack -o app/src/main/assets/audio.bank --rate 22050 --mono BGM.wav GameOverBGM.wav menuBGM.wav
+//     audiobank list app/src/main/assets/audio.bank
+//
+// The bank must stay uncompressed in the apk so the game can map it (see noCompress in app/build.gradle.kts).
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Audio/AudioBank.h"
+#include "Audio/ImaAdpcm.h"
+#include "Audio/WavFile.h"
+
+namespace {
+    constexpr uint32_t adpcmBlockBytesPerChannel = 512;
+
+    struct PackOptions {
+        AudioCodec codec = AudioCodec::ImaAdpcm;
+        uint32_t sampleRate = 0;    // 0 keeps the input's rate
+        bool mono = false;
+    };
+
+    struct Track {
+        AudioBankTrack entry;
+        std::vector<uint8_t> data;
+    };
+
+    void printUsage() {
+        std::fprintf(stderr,
+                "usage:\n"
+                "  audiobank pack -o <out.bank> [options] [name=]<in.wav> ...\n"
+                "      options apply to the inputs that follow them:\n"
+                "        --adpcm       4-bit ima-adpcm (default)\n"
+                "        --pcm         uncompressed 16-bit\n"
+                "        --rate <hz>   resample to hz (default keeps the input rate)\n"
+                "        --mono        downmix to one channel\n"
+                "      the track name defaults to the file name without its extension.\n"
+                "  audiobank list <in.bank>\n"
+                "  audiobank extract <in.bank> <name> <out.wav>\n");
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool writeFile(const std::string& path, std::vector<uint8_t> const& data) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t>& out, T const& value) {
+        auto const* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<int16_t> downmix(std::vector<int16_t> const& samples, uint32_t channels) {
+        if (channels == 1)
+            return samples;
+        std::vector<int16_t> mono(samples.size() / channels);
+        for (size_t f = 0; f < mono.size(); ++f) {
+            int32_t sum = 0;
+            for (uint32_t c = 0; c < channels; ++c)
+                sum += samples[f * channels + c];
+            mono[f] = static_cast<int16_t>(sum / static_cast<int32_t>(channels));
+        }
+        return mono;
+    }
+
+    // linear interpolation, good enough for music going down to 22kHz and for sfx.
+    std::vector<int16_t> resample(std::vector<int16_t> const& samples, uint32_t channels, uint32_t from, uint32_t to) {
+        if (from == to || samples.empty())
+            return samples;
+        size_t const inFrames = samples.size() / channels;
+        auto const outFrames = static_cast<size_t>(static_cast<double>(inFrames) * to / from);
+        std::vector<int16_t> out(outFrames * channels);
+        for (size_t f = 0; f < outFrames; ++f) {
+            double const position = static_cast<double>(f) * from / to;
+            auto const index = static_cast<size_t>(position);
+            double const t = position - static_cast<double>(index);
+            size_t const nextIndex = std::min(index + 1, inFrames - 1);
+            for (uint32_t c = 0; c < channels; ++c) {
+                double const a = samples[index * channels + c];
+                double const b = samples[nextIndex * channels + c];
+                out[f * channels + c] = static_cast<int16_t>(a + (b - a) * t);
+            }
+        }
+        return out;
+    }
+
+    bool buildTrack(const std::string& name, const std::string& path, PackOptions const& options, Track& track) {
+        std::vector<uint8_t> file;
+        WavView wav{};
+        if (!readFile(path, file) || !parseWav(file.data(), file.size(), wav)) {
+            std::fprintf(stderr, "%s: not a pcm wav file\n", path.c_str());
+            return false;
+        }
+        if (wav.bitsPerSample != 16 || wav.channels < 1 || wav.channels > 2) {
+            std::fprintf(stderr, "%s: only 16-bit mono or stereo is supported\n", path.c_str());
+            return false;
+        }
+        if (name.size() >= audioBankNameLength) {
+            std::fprintf(stderr, "%s: track name is longer than %u characters\n", name.c_str(), audioBankNameLength - 1);
+            return false;
+        }
+
+        std::vector<int16_t> samples(static_cast<size_t>(wav.frameCount) * wav.channels);
+        std::memcpy(samples.data(), wav.samples, samples.size() * sizeof(int16_t));
+        uint32_t channels = wav.channels;
+        if (options.mono) {
+            samples = downmix(samples, channels);
+            channels = 1;
+        }
+        uint32_t const sampleRate = options.sampleRate ? options.sampleRate : wav.sampleRate;
+        samples = resample(samples, channels, wav.sampleRate, sampleRate);
+        auto const frameCount = static_cast<uint32_t>(samples.size() / channels);
+
+        AudioBankTrack& entry = track.entry;
+        entry = AudioBankTrack{};
+        std::strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+        entry.codec = options.codec;
+        entry.sampleRate = sampleRate;
+        entry.channels = channels;
+        entry.frameCount = frameCount;
+
+        if (options.codec == AudioCodec::Pcm16) {
+            track.data.resize(samples.size() * sizeof(int16_t));
+            std::memcpy(track.data.data(), samples.data(), track.data.size());
+        } else {
+            entry.blockBytes = adpcmBlockBytesPerChannel * channels;
+            entry.framesPerBlock = ImaAdpcm::framesPerBlock(entry.blockBytes, channels);
+            uint32_t const blocks = (frameCount + entry.framesPerBlock - 1) / entry.framesPerBlock;
+            track.data.resize(static_cast<size_t>(blocks) * entry.blockBytes);
+            for (uint32_t b = 0; b < blocks; ++b) {
+                uint32_t const first = b * entry.framesPerBlock;
+                ImaAdpcm::encodeBlock(samples.data() + static_cast<size_t>(first) * channels,
+                                      std::min(entry.framesPerBlock, frameCount - first), channels,
+                                      track.data.data() + static_cast<size_t>(b) * entry.blockBytes, entry.blockBytes);
+            }
+        }
+        entry.dataSize = track.data.size();
+
+        std::printf("  %-24s %s %uHz %uch %.1fs, %zu bytes (from %zu)\n", entry.name,
+                    options.codec == AudioCodec::Pcm16 ? "pcm  " : "adpcm", sampleRate, channels,
+                    static_cast<double>(frameCount) / sampleRate, track.data.size(), file.size());
+        return true;
+    }
+
+    int pack(int argc, char** argv) {
+        std::string output;
+        PackOptions options;
+        std::vector<Track> tracks;
+
+        for (int i = 0; i < argc; ++i) {
+            std::string const arg = argv[i];
+            if (arg == "-o" && i + 1 < argc) {
+                output = argv[++i];
+            } else if (arg == "--adpcm") {
+                options.codec = AudioCodec::ImaAdpcm;
+            } else if (arg == "--pcm") {
+                options.codec = AudioCodec::Pcm16;
+            } else if (arg == "--rate" && i + 1 < argc) {
+                options.sampleRate = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--mono") {
+                options.mono = true;
+            } else if (!arg.empty() && arg[0] == '-') {
+                printUsage();
+                return 1;
+            } else {
+                // name=path, or just a path named after its stem
+                std::string name, path;
+                size_t const equals = arg.find('=');
+                if (equals != std::string::npos) {
+                    name = arg.substr(0, equals);
+                    path = arg.substr(equals + 1);
+                } else {
+                    path = arg;
+                    size_t const slash = path.find_last_of('/');
+                    name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+                    name = name.substr(0, name.find_last_of('.'));
+                }
+                tracks.emplace_back();
+                if (!buildTrack(name, path, options, tracks.back()))
+                    return 1;
+            }
+        }
+        if (output.empty() || tracks.empty()) {
+            printUsage();
+            return 1;
+        }
+
+        // header, then the index, then each track's data on its own aligned offset.
+        std::vector<uint8_t> bank;
+        AudioBankHeader header{};
+        std::memcpy(header.magic, audioBankMagic, sizeof(header.magic));
+        header.version = audioBankVersion;
+        header.trackCount = static_cast<uint32_t>(tracks.size());
+        header.indexOffset = sizeof(AudioBankHeader);
+
+        uint64_t offset = header.indexOffset + tracks.size() * sizeof(AudioBankTrack);
+        for (Track& track : tracks) {
+            offset = (offset + audioBankDataAlignment - 1) / audioBankDataAlignment * audioBankDataAlignment;
+            track.entry.dataOffset = offset;
+            offset += track.data.size();
+        }
+
+        append(bank, header);
+        for (Track const& track : tracks)
+            append(bank, track.entry);
+        for (Track const& track : tracks) {
+            bank.resize(track.entry.dataOffset, 0);
+            bank.insert(bank.end(), track.data.begin(), track.data.end());
+        }
+
+        // read it back through the runtime's parser before calling it done.
+        AudioBank check;
+        if (!check.open(bank.data(), bank.size())) {
+            std::fprintf(stderr, "internal error: the written bank does not validate\n");
+            return 1;
+        }
+        if (!writeFile(output, bank)) {
+            std::fprintf(stderr, "%s: could not write\n", output.c_str());
+            return 1;
+        }
+        std::printf("wrote %s, %zu tracks, %zu bytes\n", output.c_str(), tracks.size(), bank.size());
+        return 0;
+    }
+
+    bool openBank(const char* path, std::vector<uint8_t>& file, AudioBank& bank) {
+        if (!readFile(path, file) || !bank.open(file.data(), file.size())) {
+            std::fprintf(stderr, "%s: not a valid audio bank\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    int list(const char* path) {
+        std::vector<uint8_t> file;
+        AudioBank bank;
+        if (!openBank(path, file, bank))
+            return 1;
+        for (uint32_t i = 0; i < bank.trackCount(); ++i) {
+            AudioBankTrack const& track = bank.track(i);
+            std::printf("%-24s %s %6uHz %uch %8.2fs @%-10llu %llu bytes\n", track.name,
+                        track.codec == AudioCodec::Pcm16 ? "pcm  " : "adpcm", track.sampleRate, track.channels,
+                        static_cast<double>(track.frameCount) / track.sampleRate,
+                        static_cast<unsigned long long>(track.dataOffset),
+                        static_cast<unsigned long long>(track.dataSize));
+        }
+        return 0;
+    }
+
+    int extract(const char* path, const char* name, const char* output) {
+        std::vector<uint8_t> file;
+        AudioBank bank;
+        if (!openBank(path, file, bank))
+            return 1;
+        AudioBankTrack const* track = bank.find(name);
+        if (track == nullptr) {
+            std::fprintf(stderr, "%s: no track named %s\n", path, name);
+            return 1;
+        }
+
+        std::vector<int16_t> samples(static_cast<size_t>(track->frameCount) * track->channels);
+        const uint8_t* data = bank.trackData(*track);
+        if (track->codec == AudioCodec::Pcm16) {
+            std::memcpy(samples.data(), data, samples.size() * sizeof(int16_t));
+        } else {
+            std::vector<int16_t> block(static_cast<size_t>(track->framesPerBlock) * track->channels);
+            for (uint32_t first = 0, b = 0; first < track->frameCount; first += track->framesPerBlock, ++b) {
+                ImaAdpcm::decodeBlock(data + static_cast<size_t>(b) * track->blockBytes, track->blockBytes,
+                                      track->channels, block.data());
+                uint32_t const frames = std::min(track->framesPerBlock, track->frameCount - first);
+                std::copy_n(block.begin(), frames * track->channels, samples.begin() + static_cast<size_t>(first) * track->channels);
+            }
+        }
+
+        uint32_t const dataBytes = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+        std::vector<uint8_t> wav;
+        wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+        append(wav, static_cast<uint32_t>(36 + dataBytes));
+        wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+        append(wav, static_cast<uint32_t>(16));
+        append(wav, static_cast<uint16_t>(1));
+        append(wav, static_cast<uint16_t>(track->channels));
+        append(wav, track->sampleRate);
+        append(wav, track->sampleRate * track->channels * 2);
+        append(wav, static_cast<uint16_t>(track->channels * 2));
+        append(wav, static_cast<uint16_t>(16));
+        wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+        append(wav, dataBytes);
+        auto const* bytes = reinterpret_cast<const uint8_t*>(samples.data());
+        wav.insert(wav.end(), bytes, bytes + dataBytes);
+
+        if (!writeFile(output, wav)) {
+            std::fprintf(stderr, "%s: could not write\n", output);
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "pack") == 0)
+        return pack(argc - 2, argv + 2);
+    if (argc == 3 && std::strcmp(argv[1], "list") == 0)
+        return list(argv[2]);
+    if (argc == 5 && std::strcmp(argv[1], "extract") == 0)
+        return extract(argv[2], argv[3], argv[4]);
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,180 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Drives the game's AudioMixer (see Audio/AudioMixer.h) the way AudioManager's buffer queue
+// callback does, but from a fake clock, and checks what AudioStats reports:
+//
+//   steady    a callback every 256 frames, no jitter, the interval percentiles sit on the period.
+//   jitter    callbacks alternately 0.5 ms early and late, the jitter and percentiles follow.
+//   skipped   the audio thread misses one callback, the device drains the queue, one underrun.
+//   latency   play requests reach the output at the next callback, a late one includes the stall.
+//
+// Exits with 1 when any check fails.
+//
+//     audiomixertest
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Audio/AudioMixer.h"
+#include "Audio/AudioStats.h"
+
+namespace {
+    // same buffer queue as AudioManager.
+    constexpr uint32_t bufferFrames = 256;
+    constexpr uint32_t bufferCount  = 2;
+
+    int failures = 0;
+
+    void check(bool passed, char const* what) {
+        std::printf("  %s %s\n", passed ? "ok  " : "FAIL", what);
+        if (!passed)
+            ++failures;
+    }
+
+    bool near(float value, float expected, float tolerance) {
+        return std::fabs(value - expected) <= tolerance;
+    }
+
+    // start of the i-th buffer, exact so the intervals don't drift.
+    int64_t bufferStartNs(int64_t i) {
+        return i * bufferFrames * 1'000'000'000LL / AudioMixer::sampleRate;
+    }
+
+    float const periodMs = bufferFrames * 1000.f / AudioMixer::sampleRate;
+
+    /*!
+     * A device with a two buffer queue. It finishes one buffer per period and asks for the next
+     * one, the callback refills the queue like AudioManager::mixerQueueCallback. A stalled audio
+     * thread runs the callbacks it missed back to back once it's scheduled again.
+     */
+    struct FakeDevice {
+        AudioStatsCollector stats;
+        AudioMixer mixer{stats};
+        uint32_t queued = bufferCount;
+        uint32_t missedCallbacks = 0;
+        int16_t buffer[bufferFrames * AudioMixer::outputChannels]{};
+        int32_t peak = 0;
+
+        void callback(int64_t nowNs) {
+            stats.recordCallback(nowNs, queued, bufferCount);
+            mixer.render(buffer, bufferFrames, nowNs);
+            queued = std::min(queued + 1, bufferCount);
+            for (int16_t sample : buffer)
+                peak = std::max(peak, std::abs(static_cast<int32_t>(sample)));
+        }
+
+        // one period: the device plays a buffer, then the callback runs at nowNs unless stalled.
+        void step(int64_t nowNs, bool stalled = false) {
+            if (queued > 0)
+                --queued;
+            ++missedCallbacks;
+            if (stalled)
+                return;
+            for (; missedCallbacks > 0; --missedCallbacks)
+                callback(nowNs);
+        }
+    };
+
+    constexpr int periods = 200;
+
+    void steady() {
+        std::printf("steady\n");
+        FakeDevice device;
+        for (int i = 1; i <= periods; ++i)
+            device.step(bufferStartNs(i));
+
+        AudioStats const stats = device.stats.snapshot();
+        check(stats.callbackCount == periods, "every period ran its callback");
+        check(near(stats.callbackIntervalMeanMs, periodMs, 0.01f), "mean interval is the buffer period");
+        check(stats.callbackJitterMs < 0.01f, "no jitter");
+        check(near(stats.callbackIntervalP50Ms, periodMs, 0.25f), "p50 on the period");
+        check(near(stats.callbackIntervalP99Ms, periodMs, 0.25f), "p99 on the period");
+        check(stats.underruns == 0, "no underruns");
+        check(near(stats.bufferFillMean, 0.5f, 0.01f), "one of two buffers queued at each callback");
+    }
+
+    void jitter() {
+        std::printf("jitter\n");
+        FakeDevice device;
+        for (int i = 1; i <= periods; ++i) {
+            int64_t const offsetNs = (i % 2 == 0) ? -500'000 : 500'000;
+            device.step(bufferStartNs(i) + offsetNs);
+        }
+
+        // the intervals alternate between the period minus and plus 1 ms, starting short so the
+        // short ones are the majority.
+        AudioStats const stats = device.stats.snapshot();
+        check(near(stats.callbackIntervalMeanMs, periodMs, 0.02f), "mean interval is the buffer period");
+        check(near(stats.callbackJitterMs, 1.f, 0.01f), "jitter is 1 ms");
+        check(near(stats.callbackIntervalP50Ms, periodMs - 1.f, 0.25f), "p50 on the short interval");
+        check(near(stats.callbackIntervalP99Ms, periodMs + 1.f, 0.25f), "p99 on the long interval");
+        check(near(stats.callbackIntervalMaxMs, periodMs + 1.f, 0.01f), "max is the long interval");
+        check(stats.underruns == 0, "no underruns");
+    }
+
+    void skipped() {
+        std::printf("skipped\n");
+        FakeDevice device;
+        for (int i = 1; i <= periods; ++i)
+            device.step(bufferStartNs(i), i == periods / 2);
+
+        // the late callback waited two periods and found the queue empty, the one it missed
+        // right behind it. a single stall stays out of p99 but shows in the max.
+        AudioStats const stats = device.stats.snapshot();
+        check(stats.callbackCount == periods, "missed callback ran late");
+        check(stats.underruns == 1, "one underrun");
+        check(near(stats.callbackIntervalMaxMs, 2.f * periodMs, 0.01f), "max interval is two periods");
+        check(near(stats.callbackIntervalP99Ms, periodMs, 0.25f), "p99 still on the period");
+        check(stats.bufferFillMin == 0.f, "queue seen empty");
+
+        AudioStats const next = device.stats.snapshot();
+        check(next.callbackCount == 0 && next.underruns == 1, "window resets, underruns stay a total");
+    }
+
+    void latency() {
+        std::printf("latency\n");
+        std::vector<int16_t> pcm(bufferFrames * 4, 8000);
+        AudioSource const source = AudioSource::pcm16(pcm.data(), static_cast<uint32_t>(pcm.size()), 1,
+                                                      AudioMixer::sampleRate);
+
+        FakeDevice device;
+        device.step(bufferStartNs(1));
+        // requested 1 ms after a callback, it is mixed into the next one.
+        check(device.mixer.play(source, 1.f, false, bufferStartNs(1) + 1'000'000) >= 0, "play accepted");
+        device.step(bufferStartNs(2));
+        check(device.peak > 0, "first sample rendered");
+
+        AudioStats stats = device.stats.snapshot();
+        check(stats.playLatencySamples == 1, "one latency sample");
+        check(near(stats.playLatencyMeanMs, periodMs - 1.f, 0.01f), "latency is the time to the next callback");
+
+        for (int i = 3; i <= 8; ++i)
+            device.step(bufferStartNs(i));
+        stats = device.stats.snapshot();
+        check(stats.playLatencySamples == 0, "a playing voice is only measured once");
+
+        // this one waits through a missed callback.
+        check(device.mixer.play(source, 1.f, false, bufferStartNs(8) + 1'000'000) >= 0, "play accepted");
+        device.step(bufferStartNs(9), true);
+        device.step(bufferStartNs(10));
+        stats = device.stats.snapshot();
+        check(stats.playLatencySamples == 1, "one latency sample");
+        check(near(stats.playLatencyMaxMs, 2.f * periodMs - 1.f, 0.01f), "latency includes the stall");
+    }
+}
+
+int main() {
+    steady();
+    jitter();
+    skipped();
+    latency();
+
+    std::printf("%s, %d failed\n", failures == 0 ? "pass" : "fail", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Times the collision Broadphase (see Game/Collision/Broadphase.h) against an all pairs check, from
+// a hundred to a hundred thousand boxes. Boxes are scattered over a screen wide world that grows in
+// height with the count, so the density (and pairs per box) stays the same, and drift a little
+// every frame like moving entities do. Up to 20000 boxes the last frame's pairs are checked against
+// the all pairs ones, and any difference makes it exit with 1.
+//
+//     broadphasebench [frames]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "Core/Random.h"
+#include "Game/Collision/Broadphase.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float worldWidth = 1080.f;
+    constexpr float areaPerBox = 150.f * 150.f;
+    // all pairs gets too slow to time past this.
+    constexpr std::size_t bruteForceLimit = 20'000;
+
+    struct Body {
+        glm::vec2 center;
+        glm::vec2 size;
+        glm::vec2 velocity;
+    };
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    using PairSet = std::vector<std::pair<ProxyId, ProxyId>>;
+
+    // (lower id, higher id), sorted, so two pair lists compare as sets.
+    void normalize(PairSet& pairs) {
+        for (auto& pair : pairs) {
+            if (pair.first > pair.second)
+                std::swap(pair.first, pair.second);
+        }
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+    PairSet allPairs(std::vector<Body> const& bodies, std::vector<ProxyId> const& proxies) {
+        PairSet pairs;
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            AABB const a = AABB::fromCenter(bodies[i].center, bodies[i].size);
+            for (std::size_t j = i + 1; j < bodies.size(); ++j) {
+                if (overlaps(a, AABB::fromCenter(bodies[j].center, bodies[j].size)))
+                    pairs.emplace_back(proxies[i], proxies[j]);
+            }
+        }
+        normalize(pairs);
+        return pairs;
+    }
+
+    // returns false when the broadphase and all pairs disagree.
+    bool run(std::size_t count, int frames) {
+        Random random{count};
+        float const worldHeight = static_cast<float>(count) * areaPerBox / worldWidth;
+        std::vector<Body> bodies(count);
+        for (Body& body : bodies) {
+            body.center = glm::vec2{random.nextFloat(0.f, worldWidth), random.nextFloat(0.f, worldHeight)};
+            body.size = glm::vec2{random.nextFloat(20.f, 175.f), random.nextFloat(20.f, 150.f)};
+            body.velocity = glm::vec2{random.nextFloat(-300.f, 300.f), random.nextFloat(-300.f, 300.f)};
+        }
+
+        Broadphase broadphase{count, count * 4};
+        std::vector<ProxyId> proxies(count);
+        for (std::size_t i = 0; i < count; ++i)
+            proxies[i] = broadphase.add(AABB::fromCenter(bodies[i].center, bodies[i].size), EntityType::Platform, 0);
+
+        // the first pass sorts from insertion order, every later one only repairs it.
+        auto start = Clock::now();
+        broadphase.findPairs();
+        double const coldMs = millisecondsSince(start);
+
+        constexpr float dt = 1.f / 60.f;
+        double totalMs = 0.0;
+        std::size_t totalMoves = 0;
+        std::size_t totalPairs = 0;
+        for (int frame = 0; frame < frames; ++frame) {
+            for (std::size_t i = 0; i < count; ++i) {
+                Body& body = bodies[i];
+                body.center += body.velocity * dt;
+                if (body.center.x < 0.f || body.center.x > worldWidth)
+                    body.velocity.x = -body.velocity.x;
+                if (body.center.y < 0.f || body.center.y > worldHeight)
+                    body.velocity.y = -body.velocity.y;
+                broadphase.update(proxies[i], AABB::fromCenter(body.center, body.size));
+            }
+            start = Clock::now();
+            broadphase.findPairs();
+            totalMs += millisecondsSince(start);
+            totalMoves += broadphase.lastSortMoves();
+            totalPairs += broadphase.getPairs().size();
+        }
+
+        char brute[48] = "-";
+        bool match = true;
+        if (count <= bruteForceLimit) {
+            start = Clock::now();
+            PairSet const expected = allPairs(bodies, proxies);
+            double const bruteMs = millisecondsSince(start);
+            PairSet found;
+            for (ProxyPair const& pair : broadphase.getPairs())
+                found.emplace_back(pair.a, pair.b);
+            normalize(found);
+            match = found == expected;
+            std::snprintf(brute, sizeof(brute), "%10.3f%s", bruteMs, match ? "" : " MISMATCH");
+        }
+
+        std::printf("%8zu %10.3f %10.4f %12.1f %10.1f %s\n", count, coldMs, totalMs / frames,
+                    static_cast<double>(totalMoves) / frames, static_cast<double>(totalPairs) / frames, brute);
+        return match;
+    }
+}
+
+int main(int argc, char** argv) {
+    int const frames = argc > 1 ? std::atoi(argv[1]) : 100;
+    if (frames <= 0) {
+        std::fprintf(stderr, "usage:\n  broadphasebench [frames]\n");
+        return 1;
+    }
+
+    std::printf("%8s %10s %10s %12s %10s %10s\n", "boxes", "cold ms", "frame ms", "sort moves", "pairs", "all pairs ms");
+    bool match = true;
+    for (std::size_t count : {100u, 1'000u, 10'000u, 100'000u})
+        match = run(count, frames) && match;
+    return match ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Runs DoodleGame without a window, GL or audio, played by the Autopilot (see Game/Autopilot.h),
+// to get long, representative sessions for benchmarks and soak tests. Every game runs for the given
+// number of simulated minutes at a fixed step, a new run starts as soon as the bot falls out, and
+// the time spent in DoodleGame::update is measured per frame.
+//
+// Runs are seeded from --seed, the game and the run number, so the same options replay the same
+// frames. Games are spread over a pool of worker threads, one per core by default. Each game has a
+// JobSystem of its own, without workers unless --jobs asks for them, the games fill the cores already.
+//
+//     headless --games 8 --minutes 30
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Game/DoodleGame.h"
+#include "Game/GameHost.h"
+#include "Game/Autopilot.h"
+#include "Graphics/Camera.h"
+#include "Core/UiEventChannel.h"
+#include "Core/JobSystem.h"
+
+namespace {
+    struct Options {
+        unsigned games    = 4;
+        float    minutes  = 10.f;        // simulated, per game
+        float    hz       = 60.f;
+        unsigned threads  = 0;           // 0 = one per core
+        unsigned jobs     = 0;           // job workers per game
+        uint64_t seed     = 1;
+        float    width    = 1080.f;      // screen size in pixels, the game's world units
+        float    height   = 2400.f;
+    };
+
+    void printUsage() {
+        Options const defaults;
+        std::fprintf(stderr,
+                "usage:\n"
+                "  headless [options]\n"
+                "    --games <n>       games run side by side (default %u)\n"
+                "    --minutes <m>     simulated minutes per game (default %.0f)\n"
+                "    --hz <rate>       simulation steps per second (default %.0f)\n"
+                "    --threads <n>     worker threads (default one per core)\n"
+                "    --jobs <n>        job system workers of every game (default %u)\n"
+                "    --seed <n>        base seed of every run (default %llu)\n"
+                "    --width <px>      screen width (default %.0f)\n"
+                "    --height <px>     screen height (default %.0f)\n",
+                defaults.games, defaults.minutes, defaults.hz, defaults.jobs,
+                static_cast<unsigned long long>(defaults.seed), defaults.width, defaults.height);
+    }
+
+    // the game's side of the engine with nothing behind it: no textures, no sound, and the bot's
+    // tilt instead of the accelerometer.
+    class HeadlessHost : public GameHost {
+    public:
+        explicit HeadlessHost(unsigned jobWorkers) : jobs{jobWorkers} {}
+
+        GLuint getTextureId(std::string const&) override { return NO_TEXTURE; }
+        SoundId preloadSound(const char*) override { return SoundId{}; }
+        void playMusic(SoundId, bool) override {}
+        glm::vec3 GetAccelerometerAcceleration() const override { return tilt; }
+        JobSystem& getJobs() override { return jobs; }
+
+        glm::vec3 tilt{0.f};
+        JobSystem jobs;
+    };
+
+    struct GameResult {
+        uint64_t frames = 0;
+        uint64_t runs = 0;           // started, the last one is usually cut short by the time limit
+        uint64_t deaths = 0;
+        double   scoreSum = 0.0;     // over the runs that ended
+        float    bestScore = 0.f;
+        std::vector<uint32_t> updateNs;
+    };
+
+    GameResult runGame(Options const& options, unsigned index) {
+        auto const frames = static_cast<uint64_t>(std::llround(options.minutes * 60.0 * options.hz));
+        float const deltaTime = 1.f / options.hz;
+
+        HeadlessHost host{options.jobs};
+        Camera camera{};
+        camera.position = glm::vec2{0.f};
+        camera.scale = glm::vec2{options.width, options.height};
+        // nobody drains it, the events just drop once the ring is full.
+        UiEventChannel events;
+        DoodleGame game{host, camera, events};
+        game.preloadAudio();
+        Autopilot autopilot;
+
+        GameResult result;
+        result.updateNs.reserve(frames);
+        for (uint64_t frame = 0; frame < frames; ++frame) {
+            DoodleGame::GameState const state = game.getState();
+            if (state == DoodleGame::GameState::Awake || state == DoodleGame::GameState::GameOver) {
+                if (state == DoodleGame::GameState::GameOver) {
+                    ++result.deaths;
+                    result.scoreSum += game.getScore();
+                    result.bestScore = std::max(result.bestScore, game.getScore());
+                }
+                // distinct and reproducible for every (game, run).
+                game.setSeed(options.seed + (static_cast<uint64_t>(index) << 32u) + result.runs);
+                game.StartGame();
+                ++result.runs;
+            }
+
+            host.tilt = autopilot.steer(game, deltaTime);
+            auto const start = std::chrono::steady_clock::now();
+            game.update(deltaTime);
+            game.updateUI(deltaTime);
+            auto const elapsed = std::chrono::steady_clock::now() - start;
+            result.updateNs.push_back(static_cast<uint32_t>(std::min<int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), UINT32_MAX)));
+        }
+        if (game.getState() == DoodleGame::GameState::Playing)
+            result.bestScore = std::max(result.bestScore, game.getScore());
+        result.frames = frames;
+        return result;
+    }
+
+    double percentileUs(std::vector<uint32_t>& samples, double fraction) {
+        if (samples.empty())
+            return 0.0;
+        auto const rank = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank), samples.end());
+        return samples[rank] / 1000.0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--games") == 0)
+            options.games = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--minutes") == 0)
+            options.minutes = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--hz") == 0)
+            options.hz = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--threads") == 0)
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--jobs") == 0)
+            options.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--seed") == 0)
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--width") == 0)
+            options.width = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--height") == 0)
+            options.height = std::strtof(argv[++i], nullptr);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.games == 0 || !(options.minutes > 0.f) || !(options.hz > 0.f)
+        || !(options.width > 0.f) || !(options.height > 0.f)) {
+        printUsage();
+        return 1;
+    }
+
+    unsigned const threadCount = std::min(options.games, options.threads != 0
+            ? options.threads
+            : std::max(1u, std::thread::hardware_concurrency()));
+
+    // the game logs every run's seed, the log thread isn't started so those records are dropped.
+    std::vector<GameResult> results(options.games);
+    std::atomic<unsigned> nextGame{0};
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&] {
+            for (unsigned game = nextGame++; game < options.games; game = nextGame++)
+                results[game] = runGame(options, game);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    double const wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    GameResult total;
+    for (GameResult& result : results) {
+        total.frames += result.frames;
+        total.runs += result.runs;
+        total.deaths += result.deaths;
+        total.scoreSum += result.scoreSum;
+        total.bestScore = std::max(total.bestScore, result.bestScore);
+        total.updateNs.insert(total.updateNs.end(), result.updateNs.begin(), result.updateNs.end());
+        result.updateNs = {};
+    }
+    double updateSum = 0.0;
+    for (uint32_t ns : total.updateNs)
+        updateSum += ns;
+
+    double const simulatedSeconds = static_cast<double>(total.frames) / options.hz;
+    std::printf("%u games x %.1f simulated minutes at %.0f Hz, %u threads, %u job workers per game, %.0fx%.0f\n",
+                options.games, options.minutes, options.hz, threadCount, options.jobs, options.width, options.height);
+    // a mean over no finished run would read like a score.
+    if (total.deaths > 0) {
+        std::printf("runs      %llu started, %llu ended, mean score %.0f, best %.0f\n",
+                    static_cast<unsigned long long>(total.runs), static_cast<unsigned long long>(total.deaths),
+                    total.scoreSum / static_cast<double>(total.deaths), static_cast<double>(total.bestScore));
+    } else {
+        std::printf("runs      %llu started, none ended, mean score n/a, best %.0f\n",
+                    static_cast<unsigned long long>(total.runs), static_cast<double>(total.bestScore));
+    }
+    std::printf("update    mean %.2f us, p50 %.2f, p90 %.2f, p99 %.2f, p99.9 %.2f, max %.2f us\n",
+                total.frames > 0 ? updateSum / static_cast<double>(total.frames) / 1000.0 : 0.0,
+                percentileUs(total.updateNs, 0.5), percentileUs(total.updateNs, 0.9),
+                percentileUs(total.updateNs, 0.99), percentileUs(total.updateNs, 0.999),
+                percentileUs(total.updateNs, 1.0));
+    std::printf("%llu frames in %.3f s, %.0fx real time\n",
+                static_cast<unsigned long long>(total.frames), wallSeconds, simulatedSeconds / wallSeconds);
+    return 0;
+}
@@ -0,0 +1,222 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Scaling of the JobSystem (see Core/JobSystem.h) from no workers up to one per core, on the kinds
+// of work the engine hands it:
+//
+//   compute    parallelFor over a million elements of arithmetic only, the best case.
+//   particles  parallelFor of the ParticleBatch kernel over a million particles, memory bound.
+//   broadphase Broadphase::findPairs with 50k scattered boxes, checked against the serial sweep.
+//   graph      two stages of 64 small jobs, the second queued with runAfter on the first, for the
+//              cost of a job and of a dependency. the second stage checks the first finished.
+//
+// Times are the mean of --repeats runs after one warm up, the speedup is against no workers, where
+// everything runs on the calling thread.
+//
+//     jobbench --workers 0,1,3,7 --repeats 20
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Core/Random.h"
+#include "Game/Collision/Broadphase.h"
+#include "Game/Particles/ParticleBatch.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t elementCount = 1'000'000;
+    constexpr std::size_t boxCount = 50'000;
+    constexpr std::size_t stageJobs = 64;
+    constexpr float worldWidth = 1080.f;
+    constexpr float areaPerBox = 150.f * 150.f;
+
+    struct Options {
+        std::vector<unsigned> workers;
+        int repeats = 20;
+    };
+
+    void printUsage() {
+        std::fprintf(stderr,
+                "usage:\n"
+                "  jobbench [options]\n"
+                "    --workers <n,n..>   worker counts to run (default 0 up to one per core, at least 3)\n"
+                "    --repeats <n>       timed runs of every case (default 20)\n"
+                "  exits with 1 when a parallel result differs from the serial one.\n");
+    }
+
+    template <typename Work>
+    double meanMilliseconds(int repeats, Work const& work) {
+        work();
+        auto const start = Clock::now();
+        for (int r = 0; r < repeats; ++r)
+            work();
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+    }
+
+    struct Particles {
+        std::vector<float> x, y, velocityX, velocityY, gravity, life;
+
+        Particles() :
+                x(elementCount), y(elementCount), velocityX(elementCount), velocityY(elementCount),
+                gravity(elementCount, -1000.f), life(elementCount, 1e9f) {
+            Random random{7};
+            random.fillFloats(velocityX.data(), elementCount, -300.f, 300.f);
+            random.fillFloats(velocityY.data(), elementCount, -300.f, 300.f);
+        }
+
+        ParticleSoA range(std::size_t begin, std::size_t end) {
+            return ParticleSoA{x.data() + begin, y.data() + begin, velocityX.data() + begin, velocityY.data() + begin,
+                               gravity.data() + begin, life.data() + begin, end - begin};
+        }
+    };
+
+    // a stage of the graph case, every job writes its slot and the next stage checks them.
+    struct Graph {
+        std::atomic<uint32_t> first[stageJobs]{};
+        std::atomic<uint32_t> second[stageJobs]{};
+        std::atomic<uint32_t> errors{0};
+        uint32_t round = 0;
+
+        static void firstStage(void* context, std::size_t index, std::size_t) {
+            auto& graph = *static_cast<Graph*>(context);
+            graph.first[index].store(graph.round, std::memory_order_relaxed);
+        }
+
+        static void secondStage(void* context, std::size_t index, std::size_t) {
+            auto& graph = *static_cast<Graph*>(context);
+            for (auto const& slot : graph.first) {
+                if (slot.load(std::memory_order_relaxed) != graph.round)
+                    graph.errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            graph.second[index].store(graph.round, std::memory_order_relaxed);
+        }
+    };
+
+    struct Row {
+        double compute, particles, broadphase, graph;
+    };
+
+    Row runAll(unsigned workerCount, int repeats, bool& allMatch) {
+        JobSystem jobs{workerCount};
+        Row row{};
+
+        std::vector<float> values(elementCount);
+        row.compute = meanMilliseconds(repeats, [&] {
+            jobs.parallelFor(0, elementCount, 4096, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    float value = static_cast<float>(i) * 1e-6f;
+                    for (int step = 0; step < 32; ++step)
+                        value = value * (1.f - value) * 3.7f + 0.01f;
+                    values[i] = value;
+                }
+            });
+        });
+
+        Particles particles;
+        row.particles = meanMilliseconds(repeats, [&] {
+            jobs.parallelFor(0, elementCount, 16384, [&](std::size_t begin, std::size_t end) {
+                ParticleBatch::integrate(particles.range(begin, end), 1.f / 60.f);
+            });
+        });
+
+        Random random{boxCount};
+        float const worldHeight = static_cast<float>(boxCount) * areaPerBox / worldWidth;
+        Broadphase parallel{boxCount, boxCount * 4};
+        Broadphase serial{boxCount, boxCount * 4};
+        for (std::size_t i = 0; i < boxCount; ++i) {
+            glm::vec2 const center{random.nextFloat(0.f, worldWidth), random.nextFloat(0.f, worldHeight)};
+            glm::vec2 const size{random.nextFloat(20.f, 175.f), random.nextFloat(20.f, 150.f)};
+            parallel.add(AABB::fromCenter(center, size), EntityType::Platform, 0);
+            serial.add(AABB::fromCenter(center, size), EntityType::Platform, 0);
+        }
+        row.broadphase = meanMilliseconds(repeats, [&] { parallel.findPairs(jobs); });
+        serial.findPairs();
+        auto const& expected = serial.getPairs();
+        auto const& found = parallel.getPairs();
+        bool const pairsMatch = expected.size() == found.size() && std::equal(expected.begin(), expected.end(), found.begin(),
+                [](ProxyPair a, ProxyPair b) { return a.a == b.a && a.b == b.b; });
+
+        Graph graph;
+        row.graph = meanMilliseconds(repeats, [&] {
+            ++graph.round;
+            JobCounter firstDone;
+            JobCounter secondDone;
+            for (std::size_t i = 0; i < stageJobs; ++i)
+                jobs.run(&Graph::firstStage, &graph, firstDone, i);
+            for (std::size_t i = 0; i < stageJobs; ++i)
+                jobs.runAfter(firstDone, &Graph::secondStage, &graph, secondDone, i);
+            jobs.wait(secondDone);
+        });
+        bool const graphOk = graph.errors.load() == 0 && std::all_of(std::begin(graph.second), std::end(graph.second),
+                [&](auto const& slot) { return slot.load() == graph.round; });
+
+        if (!pairsMatch)
+            std::printf("workers %u: parallel broadphase pairs differ from the serial sweep\n", workerCount);
+        if (!graphOk)
+            std::printf("workers %u: dependent jobs ran before their dependency\n", workerCount);
+        allMatch = allMatch && pairsMatch && graphOk;
+        return row;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--workers") == 0) {
+            for (char* next = argv[++i]; *next != '\0';) {
+                options.workers.push_back(static_cast<unsigned>(std::strtoul(next, &next, 10)));
+                if (*next == ',')
+                    ++next;
+                else if (*next != '\0')
+                    break;
+            }
+        }
+        else if (std::strcmp(argv[i], "--repeats") == 0)
+            options.repeats = std::atoi(argv[++i]);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.workers.empty()) {
+        // a few workers even on small machines, so stealing and sleeping get exercised.
+        unsigned const most = std::max(JobSystem::defaultWorkerCount(), 3u);
+        for (unsigned workers = 0; workers <= most; ++workers)
+            options.workers.push_back(workers);
+    }
+    if (options.repeats <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    std::printf("%u hardware threads, %zu elements, %zu boxes, %zu jobs per graph stage\n",
+                std::thread::hardware_concurrency(), elementCount, boxCount, stageJobs);
+    std::printf("%8s %20s %20s %20s %12s\n", "workers", "compute ms", "particles ms", "broadphase ms", "graph us");
+    bool allMatch = true;
+    Row baseline{};
+    for (std::size_t i = 0; i < options.workers.size(); ++i) {
+        Row const row = runAll(options.workers[i], options.repeats, allMatch);
+        if (i == 0)
+            baseline = row;
+        std::printf("%8u %10.3f (%5.2fx) %10.3f (%5.2fx) %10.3f (%5.2fx) %12.2f\n", options.workers[i],
+                    row.compute, baseline.compute / row.compute,
+                    row.particles, baseline.particles / row.particles,
+                    row.broadphase, baseline.broadphase / row.broadphase,
+                    row.graph * 1000.0);
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,423 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Checks that the levels the game's LevelGenerator (see Game/LevelGenerator.h) builds can be
+// climbed, for many seeds at once. Every seed's layout is checked three ways:
+//
+//   envelope  closed form: a platform can be reached from another when it's below the apex of the
+//             jump and the player can cover the horizontal gap, starting from rest, before falling
+//             back past it. a seed passes when the top platform is reachable from the start.
+//   bot       the game's own movement and swept landing rules stepped at 60 Hz (--hz), steered by a simple
+//             controller. a seed passes when the bot lands on the top platform without falling out
+//             of the screen.
+//   chunked   the same segment streamed in chunks by Game/LevelStreamer, as the game gets it. a
+//             seed passes when every platform matches the single generate() call the others use.
+//
+// Both see every platform as static, where it spawns. moving and crumbling platforms (see
+// Game/PlatformBehaviours.h) are played for real by tools/headless.
+//
+// Seeds are spread over a pool of worker threads, one per core by default.
+//
+//     levelcheck --seeds 20000 --spacing 180
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Game/LevelGenerator.h"
+#include "Game/LevelStreamer.h"
+#include "Core/JobSystem.h"
+#include "Game/Components.h"
+#include "Game/Collision/Collision.h"
+
+namespace {
+    // what the game uses, see DoodleGame and PlayerTuning.
+    struct Tuning {
+        float gravity       = 2000.f;
+        float jumpVelocity  = PlayerTuning::jumpVelocity;
+        float maxSpeed      = PlayerTuning::maxMovementSpeed;
+        float acceleration  = PlayerTuning::movementAcceleration;     // per m/s^2 of tilt
+        float maxTilt       = 9.81f;   // the bot tilts the phone at most flat on its side
+        float playerWidth   = 150.f;
+        float playerHeight  = 150.f;
+        float platformHeight = 20.f;
+        float screenHeight  = 2400.f;
+        float startOffset   = 120.f;   // player start above the bottom of the screen
+        float firstPlatform = 400.f;   // first generated platform above the player's start
+    };
+
+    struct Options {
+        uint64_t firstSeed = 1;
+        uint64_t seeds     = 10'000;
+        float    height    = 20'000.f;   // segment height checked per seed
+        unsigned threads   = 0;          // 0 = one per core
+        float    timestep  = 1.f / 60.f; // bot simulation step
+        LevelGenerator::Params level;
+        Tuning   tuning;
+    };
+
+    void printUsage() {
+        Options const defaults;
+        std::fprintf(stderr,
+                "usage:\n"
+                "  levelcheck [options]\n"
+                "    --first-seed <n>      first seed checked (default %llu)\n"
+                "    --seeds <n>           number of consecutive seeds (default %llu)\n"
+                "    --height <units>      height of the segment checked per seed (default %.0f)\n"
+                "    --threads <n>         worker threads (default one per core)\n"
+                "    --width <units>       world width, the screen width in pixels (default %.0f)\n"
+                "    --screen-height <u>   screen height in pixels (default %.0f)\n"
+                "    --spacing <units>     vertical platform spacing (default %.0f)\n"
+                "    --platform-width <u>  platform width (default %.0f)\n"
+                "    --gravity <units/s2>  gravity (default %.0f)\n"
+                "    --jump <units/s>      jump velocity (default %.0f)\n"
+                "    --hz <rate>           bot simulation rate (default %.0f)\n"
+                "  exits with 1 when any seed fails.\n",
+                static_cast<unsigned long long>(defaults.firstSeed),
+                static_cast<unsigned long long>(defaults.seeds), defaults.height,
+                defaults.level.worldWidth, defaults.tuning.screenHeight, defaults.level.spacing,
+                defaults.level.platformWidth, defaults.tuning.gravity, defaults.tuning.jumpVelocity,
+                1.f / defaults.timestep);
+    }
+
+    // the whole segment of one seed, starting platform first. y is the platform's center.
+    std::vector<PlatformDesc> buildLevel(Options const& options, uint64_t seed) {
+        Tuning const& tuning = options.tuning;
+        float const bottom = -tuning.screenHeight / 2.f;
+        std::vector<PlatformDesc> platforms;
+        platforms.push_back(PlatformDesc{0.f, bottom, 0});
+
+        LevelGenerator generator;
+        generator.reset(options.level, seed, bottom + tuning.startOffset + tuning.firstPlatform);
+        PlatformDesc batch[64];
+        std::size_t count;
+        while ((count = generator.generate(bottom + options.height, batch, 64)) > 0)
+            platforms.insert(platforms.end(), batch, batch + count);
+        return platforms;
+    }
+
+    // ---- chunked ----
+
+    bool samePlatform(PlatformDesc const& a, PlatformDesc const& b) {
+        return a.x == b.x && a.y == b.y && a.variant == b.variant && a.kind == b.kind && a.phase == b.phase;
+    }
+
+    // streams the seed's layout the way the game does and compares it with `platforms`, the start
+    // floor aside. `stuckAt` is the first platform that differs.
+    bool checkChunked(Options const& options, LevelStreamer& streamer, uint64_t seed,
+                      std::vector<PlatformDesc> const& platforms, float& stuckAt) {
+        Tuning const& tuning = options.tuning;
+        float const bottom = -tuning.screenHeight / 2.f;
+        streamer.restart(options.level, seed, bottom + tuning.startOffset + tuning.firstPlatform);
+        LevelChunk chunk;
+        std::size_t matched = 1;
+        while (matched < platforms.size()) {
+            streamer.waitNext(chunk);
+            for (uint32_t i = 0; i < chunk.count && matched < platforms.size(); ++i, ++matched) {
+                if (!samePlatform(chunk.platforms[i], platforms[matched])) {
+                    stuckAt = platforms[matched].y;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // ---- envelope ----
+
+    // horizontal distance covered in `time` from rest, accelerating flat out up to the top speed.
+    float maxTravel(Tuning const& tuning, float time) {
+        float const accel = tuning.acceleration * tuning.maxTilt;
+        float const rampTime = tuning.maxSpeed / accel;
+        if (time <= rampTime)
+            return 0.5f * accel * time * time;
+        return 0.5f * tuning.maxSpeed * rampTime + tuning.maxSpeed * (time - rampTime);
+    }
+
+    // the player wraps around the screen edges, so the gap is the shorter way round.
+    float horizontalGap(Options const& options, float fromX, float toX) {
+        float const period = options.level.worldWidth - options.tuning.playerWidth;
+        float const direct = std::fabs(toX - fromX);
+        float const wrapped = std::max(0.f, period - direct);
+        float const overlap = (options.tuning.playerWidth + options.level.platformWidth) / 2.f;
+        return std::max(0.f, std::min(direct, wrapped) - overlap);
+    }
+
+    bool canReach(Options const& options, PlatformDesc const& from, PlatformDesc const& to,
+                  float fromWidth) {
+        Tuning const& tuning = options.tuning;
+        float const rise = to.y - from.y;
+        float const v = tuning.jumpVelocity;
+        float const discriminant = v * v - 2.f * tuning.gravity * rise;
+        if (discriminant < 0.f)
+            return false;
+        // the last moment the feet are still above the target's top, on the way down.
+        float const time = (v + std::sqrt(discriminant)) / tuning.gravity;
+        // a take off platform wider than the usual one (the starting floor) lets the player start
+        // anywhere on it.
+        float const slack = (fromWidth - options.level.platformWidth) / 2.f;
+        return std::max(0.f, horizontalGap(options, from.x, to.x) - slack) <= maxTravel(tuning, time);
+    }
+
+    // true when the top platform can be reached, `stuckAt` is the highest reachable platform.
+    bool checkEnvelope(Options const& options, std::vector<PlatformDesc> const& platforms,
+                       float& stuckAt) {
+        Tuning const& tuning = options.tuning;
+        float const apex = tuning.jumpVelocity * tuning.jumpVelocity / (2.f * tuning.gravity);
+        std::vector<uint8_t> reachable(platforms.size(), 0);
+        reachable[0] = 1;
+        std::size_t highest = 0;
+        for (std::size_t i = 0; i < platforms.size(); ++i) {
+            if (!reachable[i])
+                continue;
+            highest = i;
+            float const width = i == 0 ? options.level.worldWidth : options.level.platformWidth;
+            for (std::size_t j = i + 1; j < platforms.size() && platforms[j].y - platforms[i].y <= apex; ++j) {
+                if (!reachable[j] && canReach(options, platforms[i], platforms[j], width))
+                    reachable[j] = 1;
+            }
+        }
+        stuckAt = platforms[highest].y;
+        return highest + 1 == platforms.size();
+    }
+
+    // ---- bot ----
+
+    // steps the same movement, wrap and swept landing rules as DoodleGame::PlayTime. the bot aims for the
+    // lowest platform above the one it last landed on.
+    bool runBot(Options const& options, std::vector<PlatformDesc> const& platforms, float& reached) {
+        Tuning const& tuning = options.tuning;
+        float const dt = options.timestep;
+        float const halfWidth = options.level.worldWidth / 2.f;
+        float const xMin = -halfWidth + tuning.playerWidth / 2.f;
+        float const xMax = halfWidth - tuning.playerWidth / 2.f;
+        float const halfPlayer = tuning.playerHeight / 2.f;
+        float const halfPlatform = tuning.platformHeight / 2.f;
+
+        glm::vec2 position{0.f, -tuning.screenHeight / 2.f + tuning.startOffset};
+        glm::vec2 velocity{0.f, tuning.jumpVelocity};
+        glm::vec2 const playerSize{tuning.playerWidth, tuning.playerHeight};
+        glm::vec2 previous = position;
+        float camera = 0.f;
+        std::size_t landed = 0;
+        std::size_t scan = 0;   // platforms below this one can't be landed on any more
+
+        float const climb = platforms.back().y - platforms.front().y;
+        auto const maxSteps = static_cast<long>((climb / 100.f + 30.f) / dt);
+        for (long step = 0; step < maxSteps; ++step) {
+            // steer towards the target, taking the wrap when it's shorter.
+            PlatformDesc const& target = platforms[std::min(landed + 1, platforms.size() - 1)];
+            float dx = target.x - position.x;
+            float const period = xMax - xMin;
+            if (dx > period / 2.f)
+                dx -= period;
+            else if (dx < -period / 2.f)
+                dx += period;
+            float const wanted = std::clamp(dx * 4.f, -tuning.maxSpeed, tuning.maxSpeed);
+            float const maxDelta = tuning.acceleration * tuning.maxTilt * dt;
+            velocity.x += std::clamp(wanted - velocity.x, -maxDelta, maxDelta);
+
+            velocity.x = std::clamp(velocity.x, -tuning.maxSpeed, tuning.maxSpeed);
+            velocity.y -= dt * tuning.gravity;
+            position += dt * velocity;
+            position.x = std::clamp(position.x, xMin, xMax);
+            if (velocity.x < 0.f && position.x <= xMin)
+                position.x = xMax;
+            else if (velocity.x > 0.f && position.x >= xMax)
+                position.x = xMin;
+
+            if (velocity.y < 0.f) {
+                glm::vec2 from = previous;
+                if (std::fabs(position.x - from.x) > halfWidth)
+                    from.x = position.x;
+                float const bottom = position.y - halfPlayer;
+                while (scan < platforms.size() && platforms[scan].y + halfPlatform < bottom - tuning.screenHeight)
+                    ++scan;
+                float earliest = 1.f;
+                std::size_t hitIndex = platforms.size();
+                for (std::size_t i = scan; i < platforms.size() && platforms[i].y - halfPlatform <= from.y; ++i) {
+                    PlatformDesc const& platform = platforms[i];
+                    float const width = i == 0 ? options.level.worldWidth : options.level.platformWidth;
+                    SweepHit hit{};
+                    if (sweep(AABB::fromCenter(from, playerSize), position - from,
+                              AABB::fromCenter(glm::vec2{platform.x, platform.y}, glm::vec2{width, tuning.platformHeight}), hit)
+                        && hit.normal.y > 0.f && hit.time <= earliest) {
+                        earliest = hit.time;
+                        hitIndex = i;
+                    }
+                }
+                if (hitIndex != platforms.size()) {
+                    position.y = platforms[hitIndex].y + halfPlatform + halfPlayer;
+                    velocity.y = tuning.jumpVelocity;
+                    landed = std::max(landed, hitIndex);
+                }
+            }
+            previous = position;
+
+            camera = std::max(camera, position.y);
+            reached = platforms[landed].y;
+            if (landed + 1 == platforms.size())
+                return true;
+            if (position.y < camera - tuning.screenHeight / 2.f)
+                return false;
+        }
+        return false;
+    }
+
+    // ---- pool ----
+
+    struct Failure {
+        uint64_t    seed;
+        char const* check;
+        float       height;
+    };
+
+    struct Results {
+        uint64_t envelopeFailed = 0;
+        uint64_t botFailed      = 0;
+        uint64_t chunkedFailed  = 0;
+        uint64_t platforms      = 0;
+        std::vector<Failure> failures;   // the first few, for the report
+    };
+
+    constexpr std::size_t maxReportedFailures = 10;
+    constexpr uint64_t seedsPerClaim = 64;
+
+    // workers claim seeds in small blocks from a shared counter and merge their totals at the end.
+    Results runPool(Options const& options, unsigned threadCount) {
+        std::atomic<uint64_t> nextSeed{0};
+        std::mutex merge;
+        Results results;
+
+        auto worker = [&]() {
+            Results local;
+            // no workers, the streamer's jobs run inline on this thread.
+            JobSystem jobs{0};
+            LevelStreamer streamer{jobs};
+            for (;;) {
+                uint64_t const begin = nextSeed.fetch_add(seedsPerClaim, std::memory_order_relaxed);
+                if (begin >= options.seeds)
+                    break;
+                uint64_t const end = std::min(options.seeds, begin + seedsPerClaim);
+                for (uint64_t i = begin; i < end; ++i) {
+                    uint64_t const seed = options.firstSeed + i;
+                    std::vector<PlatformDesc> const platforms = buildLevel(options, seed);
+                    local.platforms += platforms.size();
+                    float height = 0.f;
+                    if (!checkEnvelope(options, platforms, height)) {
+                        ++local.envelopeFailed;
+                        local.failures.push_back(Failure{seed, "envelope", height});
+                    }
+                    if (!runBot(options, platforms, height)) {
+                        ++local.botFailed;
+                        local.failures.push_back(Failure{seed, "bot", height});
+                    }
+                    if (!checkChunked(options, streamer, seed, platforms, height)) {
+                        ++local.chunkedFailed;
+                        local.failures.push_back(Failure{seed, "chunked", height});
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock{merge};
+            results.envelopeFailed += local.envelopeFailed;
+            results.botFailed += local.botFailed;
+            results.chunkedFailed += local.chunkedFailed;
+            results.platforms += local.platforms;
+            results.failures.insert(results.failures.end(), local.failures.begin(), local.failures.end());
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i)
+            threads.emplace_back(worker);
+        for (std::thread& thread : threads)
+            thread.join();
+
+        std::sort(results.failures.begin(), results.failures.end(),
+                  [](Failure const& a, Failure const& b) { return a.seed < b.seed; });
+        if (results.failures.size() > maxReportedFailures)
+            results.failures.resize(maxReportedFailures);
+        return results;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--first-seed") == 0)
+            options.firstSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seeds") == 0)
+            options.seeds = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--height") == 0)
+            options.height = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--threads") == 0)
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--width") == 0)
+            options.level.worldWidth = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--screen-height") == 0)
+            options.tuning.screenHeight = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--spacing") == 0)
+            options.level.spacing = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--platform-width") == 0)
+            options.level.platformWidth = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--gravity") == 0)
+            options.tuning.gravity = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--jump") == 0)
+            options.tuning.jumpVelocity = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--hz") == 0)
+            options.timestep = 1.f / std::strtof(argv[++i], nullptr);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.seeds == 0 || options.level.spacing <= 0.f || options.tuning.gravity <= 0.f
+        || !(options.timestep > 0.f)) {
+        printUsage();
+        return 1;
+    }
+
+    unsigned const threads = options.threads != 0
+            ? options.threads
+            : std::max(1u, std::thread::hardware_concurrency());
+
+    auto const start = std::chrono::steady_clock::now();
+    Results const results = runPool(options, threads);
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("seeds %llu..%llu, %u threads, %.0f units per seed\n",
+                static_cast<unsigned long long>(options.firstSeed),
+                static_cast<unsigned long long>(options.firstSeed + options.seeds - 1),
+                threads, options.height);
+    std::printf("envelope  %llu pass, %llu fail\n",
+                static_cast<unsigned long long>(options.seeds - results.envelopeFailed),
+                static_cast<unsigned long long>(results.envelopeFailed));
+    std::printf("bot       %llu pass, %llu fail\n",
+                static_cast<unsigned long long>(options.seeds - results.botFailed),
+                static_cast<unsigned long long>(results.botFailed));
+    std::printf("chunked   %llu pass, %llu fail\n",
+                static_cast<unsigned long long>(options.seeds - results.chunkedFailed),
+                static_cast<unsigned long long>(results.chunkedFailed));
+    for (Failure const& failure : results.failures) {
+        std::printf("  seed %llu: %s stuck at %.0f\n", static_cast<unsigned long long>(failure.seed),
+                    failure.check, failure.height);
+    }
+    std::printf("%.3f s, %.0f seeds/s, %.0f platforms/s\n", seconds,
+                static_cast<double>(options.seeds) / seconds,
+                static_cast<double>(results.platforms) / seconds);
+
+    return results.envelopeFailed + results.botFailed + results.chunkedFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Stress benchmark for the particle system (see Game/Particles/ParticleSystem.h), at 10k and 100k
+// particles by default:
+//
+//   integrate  ParticleBatch::Scalar against ParticleBatch (whichever kernel this build compiled
+//              in) over one pool, in ns per particle. the results are compared, so a run is also a
+//              correctness check.
+//   steady     a full ParticleSystem held at the given count for --frames steps: particles die
+//              every step and the pool is topped up again with bursts, then packed for drawing the
+//              way the renderer does. emit, update (integrate + compaction) and pack are timed per
+//              frame.
+//
+// particlebench_avx is the same built with -mavx.
+//
+//     particlebench --particles 10000,100000 --frames 600
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Core/Random.h"
+#include "Game/Particles/ParticleSystem.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<std::size_t> counts{10'000, 100'000};
+        int   frames = 600;
+        float hz     = 60.f;
+    };
+
+    void printUsage() {
+        std::fprintf(stderr,
+                "usage:\n"
+                "  particlebench [options]\n"
+                "    --particles <n,n..>   particle counts to run (default 10000,100000)\n"
+                "    --frames <n>          steady state frames per count (default 600)\n"
+                "    --hz <rate>           simulation steps per second (default 60)\n"
+                "  exits with 1 when the kernels disagree.\n");
+    }
+
+    struct Columns {
+        std::vector<float> x, y, velocityX, velocityY, gravity, life;
+
+        explicit Columns(std::size_t count, Random& random) :
+                x(count), y(count), velocityX(count), velocityY(count), gravity(count), life(count) {
+            random.fillFloats(x.data(), count, -540.f, 540.f);
+            random.fillFloats(y.data(), count, -1200.f, 1200.f);
+            random.fillFloats(velocityX.data(), count, -500.f, 500.f);
+            random.fillFloats(velocityY.data(), count, -500.f, 500.f);
+            random.fillFloats(gravity.data(), count, -2500.f, 300.f);
+            // long lived, the kernel runs over the same particles again and again.
+            std::fill(life.begin(), life.end(), 1e9f);
+        }
+
+        ParticleSoA view() {
+            return ParticleSoA{x.data(), y.data(), velocityX.data(), velocityY.data(), gravity.data(), life.data(), x.size()};
+        }
+    };
+
+    bool close(std::vector<float> const& a, std::vector<float> const& b) {
+        // NEON fuses the multiply-add, so the last bits may differ from the scalar version.
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::fabs(a[i] - b[i]) > 1e-3f * std::max(1.f, std::fabs(a[i])))
+                return false;
+        }
+        return true;
+    }
+
+    double nanosecondsPer(std::size_t count, int repeats, Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count()
+               / (static_cast<double>(repeats) * static_cast<double>(count));
+    }
+
+    bool benchIntegrate(std::size_t count, float deltaTime) {
+        Random random{47};
+        Columns scalar{count, random};
+        Columns simd = scalar;
+        int const repeats = static_cast<int>(std::max<std::size_t>(16, (std::size_t{1} << 25) / count));
+
+        auto start = Clock::now();
+        for (int r = 0; r < repeats; ++r)
+            ParticleBatch::Scalar::integrate(scalar.view(), deltaTime);
+        double const scalarNs = nanosecondsPer(count, repeats, Clock::now() - start);
+        start = Clock::now();
+        for (int r = 0; r < repeats; ++r)
+            ParticleBatch::integrate(simd.view(), deltaTime);
+        double const simdNs = nanosecondsPer(count, repeats, Clock::now() - start);
+
+        bool const match = close(scalar.x, simd.x) && close(scalar.y, simd.y)
+                        && close(scalar.velocityY, simd.velocityY) && close(scalar.life, simd.life);
+        std::printf("%9zu  integrate  scalar %.3f ns, %s %.3f ns per particle%s\n", count, scalarNs,
+                    ParticleBatch::kernelName(), simdNs, match ? "" : "  MISMATCH");
+        return match;
+    }
+
+    void benchSteady(std::size_t count, int frames, float deltaTime) {
+        ParticleSystem particles{1, count};
+        ParticleEmitter burst;
+        burst.count = 256;
+        burst.lifeMin = 0.5f;
+        burst.lifeMax = 2.f;
+        EmitterId const emitter = particles.addEmitter(burst);
+        std::vector<ParticleInstance> instances(count);
+        Random random{53};
+
+        auto const topUp = [&] {
+            std::size_t emitted = 0;
+            std::size_t burstEmitted;
+            while ((burstEmitted = particles.emit(emitter, glm::vec2{random.nextFloat(-540.f, 540.f), 0.f})) > 0)
+                emitted += burstEmitted;
+            return emitted;
+        };
+        topUp();
+
+        Clock::duration emitTime{}, updateTime{}, packTime{};
+        std::size_t emitted = 0;
+        for (int frame = 0; frame < frames; ++frame) {
+            auto const start = Clock::now();
+            particles.update(deltaTime);
+            auto const updated = Clock::now();
+            emitted += topUp();
+            auto const toppedUp = Clock::now();
+            particles.pack(0, instances.data());
+            auto const packed = Clock::now();
+            updateTime += updated - start;
+            emitTime += toppedUp - updated;
+            packTime += packed - toppedUp;
+        }
+        auto const msPerFrame = [&](Clock::duration elapsed) {
+            return std::chrono::duration<double, std::milli>(elapsed).count() / frames;
+        };
+        std::printf("%9zu  steady     update %.3f ms (%.3f ns per particle), emit %.3f ms (%.0f per frame), pack %.3f ms\n",
+                    count, msPerFrame(updateTime), nanosecondsPer(count, frames, updateTime),
+                    msPerFrame(emitTime), static_cast<double>(emitted) / frames, msPerFrame(packTime));
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--particles") == 0) {
+            options.counts.clear();
+            for (char* next = argv[++i]; *next != '\0';) {
+                options.counts.push_back(std::strtoull(next, &next, 10));
+                if (*next == ',')
+                    ++next;
+                else if (*next != '\0')
+                    break;
+            }
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0)
+            options.frames = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--hz") == 0)
+            options.hz = std::strtof(argv[++i], nullptr);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.counts.empty() || options.frames <= 0 || !(options.hz > 0.f)
+        || std::find(options.counts.begin(), options.counts.end(), 0) != options.counts.end()) {
+        printUsage();
+        return 1;
+    }
+
+    float const deltaTime = 1.f / options.hz;
+    bool allMatch = true;
+    for (std::size_t count : options.counts) {
+        allMatch = benchIntegrate(count, deltaTime) && allMatch;
+        benchSteady(count, options.frames, deltaTime);
+    }
+    return allMatch ? 0 : 1;
+}
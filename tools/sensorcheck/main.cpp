@@ -0,0 +1,156 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Replays the checked in trace (tilt.trace, next to this file) through the game's
+// AccelerometerPipeline (see Input/AccelerometerPipeline.h) and checks it:
+//
+//   gap       after the 0.5 s pause the filter restarts from the first new sample instead of
+//             easing over from the value before it.
+//   history   the rings hold the newest samples in order, the stale one is dropped.
+//   jitter    the filter takes most of the sample to sample noise out of the trace, while
+//             staying close to it.
+//
+// Exits with 1 when any check fails. Another trace, in sensorreplay's format, can be passed in.
+//
+//     sensorcheck [trace]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Input/AccelerometerPipeline.h"
+
+namespace {
+    // filtered sample to sample noise has to come out at most this fraction of the raw one.
+    constexpr double maxJitterRatio = 0.35;
+    // and the filtered signal may not wander further than this from the raw one (rms, m/s^2).
+    constexpr double maxTrackingError = 0.4;
+
+    int failures = 0;
+
+    void check(bool passed, char const* what) {
+        std::printf("  %s %s\n", passed ? "ok  " : "FAIL", what);
+        if (!passed)
+            ++failures;
+    }
+
+    bool loadTrace(char const* path, std::vector<SensorSample>& samples) {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            long long timestamp;
+            float x, y, z;
+            if (std::sscanf(line.c_str(), "%lld,%f,%f,%f", &timestamp, &x, &y, &z) == 4)
+                samples.push_back(SensorSample{timestamp, glm::vec3{x, y, z}});
+        }
+        return !samples.empty();
+    }
+
+    double squared(glm::vec3 v) {
+        return static_cast<double>(v.x) * v.x + static_cast<double>(v.y) * v.y + static_cast<double>(v.z) * v.z;
+    }
+
+    // rms of the sample to sample change, same measure as sensorreplay.
+    double jitter(std::vector<glm::vec3> const& values) {
+        double sum = 0.0;
+        for (std::size_t i = 1; i < values.size(); ++i)
+            sum += squared(values[i] - values[i - 1]);
+        return values.size() < 2 ? 0.0 : std::sqrt(sum / static_cast<double>(values.size() - 1));
+    }
+}
+
+int main(int argc, char** argv) {
+    char const* path = argc > 1 ? argv[1] : SENSORCHECK_TRACE;
+    std::vector<SensorSample> samples;
+    if (!loadTrace(path, samples)) {
+        std::fprintf(stderr, "cannot read samples from %s\n", path);
+        return 1;
+    }
+
+    // one sample at a time, like a slow sensor queue, so every step can be looked at.
+    AccelerometerPipeline pipeline;
+    std::vector<SensorSample> accepted;
+    // raw and filtered values of the segments between gaps, jitter is measured within each.
+    std::vector<std::vector<glm::vec3>> raw(1);
+    std::vector<std::vector<glm::vec3>> filtered(1);
+    int gaps = 0;
+    bool gapRestarted = true;
+    bool gapMovedAway = true;
+
+    for (SensorSample const& sample : samples) {
+        int64_t const previousNs = pipeline.latestTimestampNs();
+        glm::vec3 const previousOut = pipeline.filtered();
+        uint32_t const droppedBefore = pipeline.droppedSamples();
+        pipeline.consume(&sample, 1);
+        if (pipeline.droppedSamples() != droppedBefore)
+            continue;
+
+        if (!accepted.empty() && sample.timestampNs - previousNs > AccelerometerPipeline::maxGapNs) {
+            // a restarted filter passes its first sample through untouched.
+            ++gaps;
+            gapRestarted = gapRestarted && pipeline.filtered() == sample.value
+                           && pipeline.getFilteredHistory().size() == 1;
+            gapMovedAway = gapMovedAway && std::sqrt(squared(sample.value - previousOut)) > 0.5;
+            raw.emplace_back();
+            filtered.emplace_back();
+        }
+        accepted.push_back(sample);
+        raw.back().push_back(sample.value);
+        filtered.back().push_back(pipeline.filtered());
+    }
+
+    std::printf("gap\n");
+    check(gaps == 1, "one gap in the trace");
+    check(gapMovedAway, "the tilt changed over the gap");
+    check(gapRestarted, "filter restarted from the first sample after it");
+
+    std::printf("history\n");
+    check(pipeline.droppedSamples() == 1, "the stale sample was dropped");
+    check(accepted.size() + pipeline.droppedSamples() == samples.size(), "every other sample accepted");
+
+    auto const& history = pipeline.getHistory();
+    std::size_t const kept = std::min(accepted.size(), AccelerometerPipeline::historySize);
+    bool newest = history.size() == kept;
+    for (std::size_t i = 0; newest && i < kept; ++i) {
+        SensorSample const& expected = accepted[accepted.size() - kept + i];
+        newest = history[i].timestampNs == expected.timestampNs && history[i].value == expected.value;
+    }
+    check(newest, "raw ring holds the newest samples, oldest first");
+
+    auto const& filteredHistory = pipeline.getFilteredHistory();
+    std::vector<glm::vec3> const& lastSegment = filtered.back();
+    std::size_t const filteredKept = std::min(lastSegment.size(), AccelerometerPipeline::historySize);
+    bool newestFiltered = filteredHistory.size() == filteredKept;
+    for (std::size_t i = 0; newestFiltered && i < filteredKept; ++i) {
+        newestFiltered = filteredHistory[i].value == lastSegment[lastSegment.size() - filteredKept + i]
+                         && filteredHistory[i].timestampNs == history[history.size() - filteredKept + i].timestampNs;
+    }
+    check(newestFiltered, "filtered ring holds the newest outputs since the gap");
+
+    std::printf("jitter\n");
+    double rawJitter = 0.0;
+    double filteredJitter = 0.0;
+    double trackingSum = 0.0;
+    std::size_t values = 0;
+    for (std::size_t segment = 0; segment < raw.size(); ++segment) {
+        rawJitter = std::max(rawJitter, jitter(raw[segment]));
+        filteredJitter = std::max(filteredJitter, jitter(filtered[segment]));
+        for (std::size_t i = 0; i < raw[segment].size(); ++i)
+            trackingSum += squared(filtered[segment][i] - raw[segment][i]);
+        values += raw[segment].size();
+    }
+    double const trackingError = std::sqrt(trackingSum / static_cast<double>(values));
+    std::printf("  raw %.4f  filtered %.4f  ratio %.3f (max %.2f)  tracking rms %.4f (max %.2f)\n",
+                rawJitter, filteredJitter, filteredJitter / rawJitter, maxJitterRatio,
+                trackingError, maxTrackingError);
+    check(filteredJitter <= rawJitter * maxJitterRatio, "jitter reduced");
+    check(trackingError <= maxTrackingError, "filtered signal follows the trace");
+
+    std::printf("%s, %d failed\n", failures == 0 ? "pass" : "fail", failures);
+    return failures == 0 ? 0 : 1;
+}
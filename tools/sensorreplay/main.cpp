@@ -0,0 +1,188 @@
+//
+// Created by Nyove on 10/19/2026.
+//
+// Replays a recorded accelerometer trace through the game's AccelerometerPipeline (see
+// Input/AccelerometerPipeline.h) and prints the filtered signal, so filter settings can be tuned
+// and checked on the desktop. With --lead it also runs the TiltPredictor and scores its guesses
+// against what the filter actually produced that much later.
+//
+// A trace is one sample per line, "timestamp_ns,x,y,z". Lines may carry a prefix up to an "accel,"
+// marker, which is what a debug build with DOODLE_SENSOR_TRACE writes to logcat:
+//
+//     adb logcat -v raw -s DoodleInput | grep accel, > tilt.trace
+//     sensorreplay tilt.trace --beta 0.3 > tilt.csv
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Input/AccelerometerPipeline.h"
+#include "Input/TiltPredictor.h"
+
+namespace {
+    void printUsage() {
+        std::fprintf(stderr,
+                "usage:\n"
+                "  sensorreplay <trace> [options]\n"
+                "    --min-cutoff <hz>     one euro minimum cutoff (default %.2f)\n"
+                "    --beta <value>        one euro speed coefficient (default %.2f)\n"
+                "    --d-cutoff <hz>       one euro derivative cutoff (default %.2f)\n"
+                "    --lead <ms>           also predict this far ahead and report the error\n"
+                "  writes \"timestamp_ns,raw_x,raw_y,raw_z,x,y,z[,px,py,pz]\" to stdout and a summary to stderr.\n",
+                OneEuroFilter::Params{}.minCutoffHz, OneEuroFilter::Params{}.beta,
+                OneEuroFilter::Params{}.derivativeCutoffHz);
+    }
+
+    bool parseSample(std::string const& line, SensorSample& sample) {
+        std::size_t const marker = line.find("accel,");
+        const char* text = line.c_str() + (marker == std::string::npos ? 0 : marker + 6);
+        long long timestamp;
+        float x, y, z;
+        if (std::sscanf(text, "%lld,%f,%f,%f", &timestamp, &x, &y, &z) != 4)
+            return false;
+        sample = SensorSample{timestamp, glm::vec3{x, y, z}};
+        return true;
+    }
+
+    // rms of the sample to sample change, a rough measure of how jittery a signal is.
+    double jitter(std::vector<glm::vec3> const& values) {
+        if (values.size() < 2)
+            return 0.0;
+        double sum = 0.0;
+        for (std::size_t i = 1; i < values.size(); ++i) {
+            glm::vec3 const delta = values[i] - values[i - 1];
+            sum += delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+        }
+        return std::sqrt(sum / static_cast<double>(values.size() - 1));
+    }
+
+    // the filtered signal at an arbitrary time, linear between samples. false past the end.
+    bool filteredAt(std::vector<SensorSample> const& series, int64_t timestampNs, glm::vec3& value) {
+        auto const next = std::lower_bound(series.begin(), series.end(), timestampNs,
+                [](SensorSample const& sample, int64_t t) { return sample.timestampNs < t; });
+        if (next == series.end() || next == series.begin())
+            return false;
+        auto const previous = next - 1;
+        float const t = static_cast<float>(timestampNs - previous->timestampNs)
+                      / static_cast<float>(next->timestampNs - previous->timestampNs);
+        value = previous->value + (next->value - previous->value) * t;
+        return true;
+    }
+
+    struct Prediction {
+        int64_t madeAtNs;
+        int64_t targetNs;
+        glm::vec3 value;
+    };
+
+    // rms distance to the filtered signal at each target, for the predictions and for simply
+    // holding the value the prediction was made from.
+    void scorePredictions(std::vector<SensorSample> const& series, std::vector<Prediction> const& predictions) {
+        double predictedError = 0.0;
+        double heldError = 0.0;
+        std::size_t scored = 0;
+        for (Prediction const& prediction : predictions) {
+            glm::vec3 actual;
+            glm::vec3 held;
+            if (!filteredAt(series, prediction.targetNs, actual) || !filteredAt(series, prediction.madeAtNs, held))
+                continue;
+            glm::vec3 const predictedDelta = prediction.value - actual;
+            glm::vec3 const heldDelta = held - actual;
+            predictedError += predictedDelta.x * predictedDelta.x + predictedDelta.y * predictedDelta.y + predictedDelta.z * predictedDelta.z;
+            heldError += heldDelta.x * heldDelta.x + heldDelta.y * heldDelta.y + heldDelta.z * heldDelta.z;
+            ++scored;
+        }
+        if (scored == 0)
+            return;
+        std::fprintf(stderr, "lead error rms, predicted %.4f  held %.4f  (%zu predictions)\n",
+                     std::sqrt(predictedError / static_cast<double>(scored)),
+                     std::sqrt(heldError / static_cast<double>(scored)), scored);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    OneEuroFilter::Params params;
+    int64_t leadNs = 0;
+    for (int i = 2; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--min-cutoff") == 0)
+            params.minCutoffHz = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--beta") == 0)
+            params.beta = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--d-cutoff") == 0)
+            params.derivativeCutoffHz = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--lead") == 0)
+            leadNs = static_cast<int64_t>(std::strtod(argv[++i], nullptr) * 1e6);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<SensorSample> samples;
+    std::string line;
+    while (std::getline(file, line)) {
+        SensorSample sample;
+        if (parseSample(line, sample))
+            samples.push_back(sample);
+    }
+    if (samples.empty()) {
+        std::fprintf(stderr, "%s has no samples\n", argv[1]);
+        return 1;
+    }
+
+    // one sample at a time, so the output can be read back after each of them.
+    AccelerometerPipeline pipeline(params);
+    TiltPredictor predictor;
+    std::vector<glm::vec3> raw;
+    std::vector<glm::vec3> filtered;
+    std::vector<SensorSample> filteredSeries;
+    std::vector<Prediction> predictions;
+    std::printf(leadNs > 0 ? "timestamp_ns,raw_x,raw_y,raw_z,x,y,z,px,py,pz\n" : "timestamp_ns,raw_x,raw_y,raw_z,x,y,z\n");
+    for (SensorSample const& sample : samples) {
+        uint32_t const droppedBefore = pipeline.droppedSamples();
+        pipeline.consume(&sample, 1);
+        if (pipeline.droppedSamples() != droppedBefore)
+            continue;
+        glm::vec3 const out = pipeline.filtered();
+        raw.push_back(sample.value);
+        filtered.push_back(out);
+        filteredSeries.push_back(SensorSample{sample.timestampNs, out});
+        std::printf("%lld,%f,%f,%f,%f,%f,%f", static_cast<long long>(sample.timestampNs),
+                    sample.value.x, sample.value.y, sample.value.z, out.x, out.y, out.z);
+        if (leadNs > 0) {
+            glm::vec3 const predicted = predictor.predict(pipeline, sample.timestampNs + leadNs);
+            predictions.push_back(Prediction{sample.timestampNs, sample.timestampNs + leadNs, predicted});
+            std::printf(",%f,%f,%f", predicted.x, predicted.y, predicted.z);
+        }
+        std::printf("\n");
+    }
+
+    double const seconds = static_cast<double>(samples.back().timestampNs - samples.front().timestampNs) * 1e-9;
+    std::fprintf(stderr, "samples %zu  dropped %u  duration %.2fs  rate %.1fHz\n",
+                 samples.size(), pipeline.droppedSamples(), seconds,
+                 seconds > 0.0 ? static_cast<double>(raw.size() - 1) / seconds : 0.0);
+    std::fprintf(stderr, "jitter raw %.4f  filtered %.4f\n", jitter(raw), jitter(filtered));
+    if (leadNs > 0)
+        scorePredictions(filteredSeries, predictions);
+    return 0;
+}